@@ -6,18 +6,34 @@
 #include "code.h"
 #include "regname.h"
 
+// the number of code structs allocated at once
+#define CODE_CHUNK_SIZE 4096
+
+// the chunk that code structs are being allocated from,
+// and how many of its code structs have been allocated.
+// (A code struct is never freed, since the compiler keeps
+// all of the code it generates until it is written out,
+// so allocating one just takes the next one in the chunk.)
+static code *code_chunk = NULL;
+static unsigned int code_chunk_used = CODE_CHUNK_SIZE;
+
 // Return a fresh code struct, with next pointer NULL
 // containing the given instruction instr.
 // If there is not enough space, bail with an error,
 // so this will never return NULL.
 static code *code_create(bin_instr_t instr)
 {
-    code *ret = (code *)malloc(sizeof(code));
-    if (ret == NULL) {
-	bail_with_error("Not enough space to allocate a code struct!");
+    if (code_chunk_used == CODE_CHUNK_SIZE) {
+	code_chunk = (code *)malloc(CODE_CHUNK_SIZE * sizeof(code));
+	if (code_chunk == NULL) {
+	    bail_with_error("Not enough space to allocate a code struct!");
+	}
+	code_chunk_used = 0;
     }
+    code *ret = &code_chunk[code_chunk_used++];
     ret->next = NULL;
     ret->instr = instr;
+    ret->stmt = 0;
     return ret;
 }
 
@@ -371,57 +387,54 @@ code *code_notr()
 // Return an empty code_seq
 code_seq code_seq_empty()
 {
-    return NULL;
+    code_seq ret = {NULL, NULL, 0};
+    return ret;
 }
 
 // Return a code_seq containing just the given code
 code_seq code_seq_singleton(code *c)
 {
-    return c;
+    c->next = NULL;
+    code_seq ret = {c, c, 1};
+    return ret;
 }
 
 
 // Is seq empty?
 bool code_seq_is_empty(code_seq seq)
 {
-    return seq == NULL;
+    return seq.first == NULL;
 }
 
 // Requires: !code_seq_is_empty(seq)
 // Return the first element of the given code sequence, seq
 code *code_seq_first(code_seq seq)
 {
-    return seq;
+    return seq.first;
 }
 
 // Requires: !code_seq_is_empty(seq)
 // Return the rest of the given sequence, seq
 code_seq code_seq_rest(code_seq seq)
 {
-    return seq->next;
+    if (seq.first == seq.last) {
+	return code_seq_empty();
+    }
+    code_seq ret = {seq.first->next, seq.last, seq.size - 1};
+    return ret;
 }
 
 // Return the size (number of instructions/words) in seq
 unsigned int code_seq_size(code_seq seq)
 {
-    unsigned int ret = 0;
-    while (!code_seq_is_empty(seq)) {
-	ret++;
-	seq = code_seq_rest(seq);
-    }
-    return ret;
+    return seq.size;
 }
 
 // Requires: !code_seq_is_empty(seq)
 // Return the last element in the given sequence
-code *code_seq_last_elem(code_seq seq)
+code *code_seq_last(code_seq seq)
 {
-    code *ret = seq;
-    while (!code_seq_is_empty(seq)) {
-	ret = seq;
-	seq = code_seq_rest(seq);
-    }
-    return ret;
+    return seq.last;
 }
 
 // Requires: c != NULL
@@ -434,10 +447,10 @@ code_seq code_seq_add_to_end(code_seq seq, code *c)
     if (code_seq_is_empty(seq)) {
 	return code_seq_singleton(c);
     }
-    // assert(!code_seq_is_empty(seq));
-    code *last = code_seq_last_elem(seq);	
-    last->next = c;
+    seq.last->next = c;
     c->next = NULL;
+    seq.last = c;
+    seq.size++;
     return seq;
 }
 
@@ -450,12 +463,26 @@ code_seq code_seq_concat(code_seq s1, code_seq s2)
     } else if (code_seq_is_empty(s2)) {
 	return s1;
     } else {
-	code *last = code_seq_last_elem(s1);
-	last->next = s2;
+	s1.last->next = s2.first;
+	s1.last = s2.last;
+	s1.size += s2.size;
 	return s1;
     }
 }
 
+// Make each instruction in seq that is not yet part of a statement's code
+// part of the code of the statement numbered stmt
+void code_seq_set_stmt(code_seq seq, unsigned int stmt)
+{
+    while (!code_seq_is_empty(seq)) {
+	code *c = code_seq_first(seq);
+	if (c->stmt == 0) {
+	    c->stmt = stmt;
+	}
+	seq = code_seq_rest(seq);
+    }
+}
+
 // Return a code sequence that load the static link that is STATIC_LINK_OFFSET
 // from (i.e., lower than) the address contained in register rb,
 // and place it in register rt.
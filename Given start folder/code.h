@@ -6,15 +6,26 @@
 #include "instruction.h"
 
 typedef struct code_s code;
-// code sequences
-typedef code *code_seq;
 
 // SRM assembly language instructions (that can be in linked lists)
 typedef struct code_s {
     code *next;
     bin_instr_t instr;
+    // the number of the statement whose code this is part of
+    // (see source_map.h), or 0 if it is not (yet) part of one
+    unsigned int stmt;
 } code;
 
+// code sequences: linked lists of instructions, which keep track of
+// their last instruction and their size, so adding to the end,
+// concatenating, and finding the size all take constant time
+// (first and last are NULL, and size is 0, in an empty sequence)
+typedef struct {
+    code *first;
+    code *last;
+    unsigned int size;
+} code_seq;
+
 // Code creation functions below
 
 // Create and return a fresh instruction
@@ -201,6 +212,13 @@ extern code_seq code_seq_add_to_end(code_seq seq, code *c);
 // This may modify the sequence s1 if both s1 and s2 are not empty
 extern code_seq code_seq_concat(code_seq s1, code_seq s2);
 
+// Make each instruction in seq that is not yet part of a statement's code
+// part of the code of the statement numbered stmt
+// (so an instruction is part of the innermost statement it was made for,
+// if each statement's code is marked after the code of the statements
+// inside it)
+extern void code_seq_set_stmt(code_seq seq, unsigned int stmt);
+
 // === Some convenience functions that may help with code generation follow===
 
 // Offset from the FP where the static link is found in an AR
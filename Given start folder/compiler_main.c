@@ -9,6 +9,7 @@
 #include "utilities.h"
 #include "symtab.h"
 #include "scope_check.h"
+#include "const_fold.h"
 #include "code.h"
 #include "gen_code.h"
 
@@ -19,24 +20,38 @@ static void usage(const char *cmdname)
     fprintf(stderr, "Usage: %s %s\n       %s %s\n       %s %s\n",
 	    cmdname, "-l codeFilename.pl0",
 	    cmdname, "-u codeFilename.pl0",
-	    cmdname, " codeFilename.pl0"
+	    cmdname, "[-g] [-r] [-s] codeFilename.pl0"
 	    );
+    fprintf(stderr, "(-g also writes a map from the program's addresses\n");
+    fprintf(stderr, " to its source lines in codeFilename.map,\n");
+    fprintf(stderr, " -r evaluates expressions in registers instead of on the stack,\n");
+    fprintf(stderr, " -s prints how many AST nodes constant folding removed)\n");
     exit(EXIT_FAILURE);
 }
 
 // If the -l option is used, then output the tokens
 // in the give file name to stdout,
-// otherwise unparse the program given in the file name argument to stdout
+// if the -u option is used, unparse the program given
+// in the file name argument to stdout,
+// otherwise compile it (and with -g, write its source map,
+// and with -r, evaluate its expressions in registers,
+// and with -s, print how many AST nodes constant folding removed)
 int main(int argc, char *argv[])
 {
     // should the lexer's tokens be shown?
     bool lexer_print_output = false;
     // should the unparse of the AST be shown?
     bool parser_unparse = false;
+    // should a map from addresses to source lines be written?
+    bool write_map = false;
+    // should expressions be evaluated in registers?
+    bool register_exprs = false;
+    // should statistics about the optimizations be printed?
+    bool print_stats = false;
     const char *cmdname = argv[0];
     argc--;
     argv++;
-    // possible options: -l, and -u
+    // possible options: -l, -u, -g, -r, and -s
     while (argc > 0 && strlen(argv[0]) >= 2 && argv[0][0] == '-') {
 	if (strcmp(argv[0],"-l") == 0) {
 	    lexer_print_output = true;
@@ -46,6 +61,18 @@ int main(int argc, char *argv[])
 	    parser_unparse = true;
 	    argc--;
 	    argv++;
+	} else if (strcmp(argv[0],"-g") == 0) {
+	    write_map = true;
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0],"-r") == 0) {
+	    register_exprs = true;
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0],"-s") == 0) {
+	    print_stats = true;
+	    argc--;
+	    argv++;
 	} else {
 	    // bad option!
 	    usage(cmdname);
@@ -74,6 +101,9 @@ int main(int argc, char *argv[])
     int len = strlen(boffilename);
     assert(len < BUFSIZ);  // it has to fit!
     strncpy(boffilename+(len-4), ".bof", 5);
+    char mapfilename[BUFSIZ];
+    strncpy(mapfilename, boffilename, BUFSIZ);
+    strncpy(mapfilename+(len-4), ".map", 5);
     // debug_print("Output going to %s\n", boffilename);
 
     if (lexer_print_output) {
@@ -100,10 +130,21 @@ int main(int argc, char *argv[])
 	return EXIT_SUCCESS;
     }
 
+    // fold the constants in the expressions
+    progast = const_fold_program(progast);
+    if (print_stats) {
+	fprintf(stderr, "constant folding removed %u AST nodes\n",
+		const_fold_nodes_removed());
+    }
+
     // generate code from the ASTs
     gen_code_initialize();
+    gen_code_set_register_exprs(register_exprs);
     BOFFILE bf = bof_write_open(boffilename);
     gen_code_program(bf, progast);
+    if (write_map) {
+	gen_code_write_map(mapfilename);
+    }
 
     return EXIT_SUCCESS;
 }
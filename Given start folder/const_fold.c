@@ -0,0 +1,291 @@
+/* $Id$ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include "ast.h"
+#include "id_use.h"
+#include "pl0.tab.h"
+#include "utilities.h"
+#include "const_fold.h"
+
+// the number of AST nodes removed so far
+static unsigned int nodes_removed = 0;
+
+// Requires: prog has been scope checked
+// Fold the constants in (the expressions of) the given program AST
+// Return the modified AST
+block_t const_fold_program(block_t prog)
+{
+    nodes_removed = 0;
+    return const_fold_block(prog);
+}
+
+// Return the number of AST nodes removed from the program
+// by the latest call of const_fold_program
+unsigned int const_fold_nodes_removed()
+{
+    return nodes_removed;
+}
+
+// Fold the constants in the block blk, and its procedures
+// Return the modified AST
+block_t const_fold_block(block_t blk)
+{
+    proc_decl_t *pdp = blk.proc_decls.proc_decls;
+    while (pdp != NULL) {
+	*(pdp->block) = const_fold_block(*(pdp->block));
+	pdp = pdp->next;
+    }
+    blk.stmt = const_fold_stmt(blk.stmt);
+    return blk;
+}
+
+// Fold the constants in the statement stmt
+// (and the statements inside it)
+// Return the modified AST
+stmt_t const_fold_stmt(stmt_t stmt)
+{
+    stmt_t *sp;
+    switch (stmt.stmt_kind) {
+    case assign_stmt:
+	*(stmt.data.assign_stmt.expr)
+	    = const_fold_expr(*(stmt.data.assign_stmt.expr));
+	break;
+    case begin_stmt:
+	sp = stmt.data.begin_stmt.stmts.stmts;
+	while (sp != NULL) {
+	    *sp = const_fold_stmt(*sp);
+	    sp = sp->next;
+	}
+	break;
+    case if_stmt:
+	stmt.data.if_stmt.condition
+	    = const_fold_condition(stmt.data.if_stmt.condition);
+	*(stmt.data.if_stmt.then_stmt)
+	    = const_fold_stmt(*(stmt.data.if_stmt.then_stmt));
+	*(stmt.data.if_stmt.else_stmt)
+	    = const_fold_stmt(*(stmt.data.if_stmt.else_stmt));
+	break;
+    case while_stmt:
+	stmt.data.while_stmt.condition
+	    = const_fold_condition(stmt.data.while_stmt.condition);
+	*(stmt.data.while_stmt.body)
+	    = const_fold_stmt(*(stmt.data.while_stmt.body));
+	break;
+    case write_stmt:
+	stmt.data.write_stmt.expr
+	    = const_fold_expr(stmt.data.write_stmt.expr);
+	break;
+    case call_stmt: case read_stmt: case skip_stmt:
+	// nothing to do!
+	break;
+    default:
+	bail_with_error("Unknown stmt_kind (%d) in const_fold_stmt!",
+			stmt.stmt_kind);
+	break;
+    }
+    return stmt;
+}
+
+// Fold the constants in the condition cond
+// Return the modified AST
+condition_t const_fold_condition(condition_t cond)
+{
+    switch (cond.cond_kind) {
+    case ck_odd:
+	cond.data.odd_cond.expr = const_fold_expr(cond.data.odd_cond.expr);
+	break;
+    case ck_rel:
+	cond.data.rel_op_cond.expr1
+	    = const_fold_expr(cond.data.rel_op_cond.expr1);
+	cond.data.rel_op_cond.expr2
+	    = const_fold_expr(cond.data.rel_op_cond.expr2);
+	break;
+    default:
+	bail_with_error("Unknown cond_kind (%d) in const_fold_condition!",
+			cond.cond_kind);
+	break;
+    }
+    return cond;
+}
+
+// Return an AST for a number expression with the given value,
+// found at the given file location
+static expr_t number_expr(file_location *floc, word_type value)
+{
+    char buf[32];
+    sprintf(buf, "%d", value);
+    char *text = (char *)malloc(strlen(buf) + 1);
+    if (text == NULL) {
+	bail_with_error("No space to allocate a folded number!");
+    }
+    strcpy(text, buf);
+    number_t num;
+    num.file_loc = floc;
+    num.text = text;
+    num.value = value;
+    return ast_expr_number(num);
+}
+
+// Return the number of AST nodes in exp
+static unsigned int expr_size(expr_t exp)
+{
+    if (exp.expr_kind != expr_bin) {
+	return 1;
+    }
+    return 1 + expr_size(*(exp.data.binary.expr1))
+	+ expr_size(*(exp.data.binary.expr2));
+}
+
+// Return true if exp has a division (which may fail when evaluated)
+static bool has_division(expr_t exp)
+{
+    if (exp.expr_kind != expr_bin) {
+	return false;
+    }
+    return exp.data.binary.arith_op.code == divsym
+	|| has_division(*(exp.data.binary.expr1))
+	|| has_division(*(exp.data.binary.expr2));
+}
+
+// Return true if e1 and e2 always have the same value
+// (as they are the same expression, using the same names)
+static bool same_expr(expr_t e1, expr_t e2)
+{
+    if (e1.expr_kind != e2.expr_kind) {
+	return false;
+    }
+    switch (e1.expr_kind) {
+    case expr_bin:
+	return e1.data.binary.arith_op.code == e2.data.binary.arith_op.code
+	    && same_expr(*(e1.data.binary.expr1), *(e2.data.binary.expr1))
+	    && same_expr(*(e1.data.binary.expr2), *(e2.data.binary.expr2));
+    case expr_ident:
+	return id_use_get_attrs(e1.data.ident.idu)
+	    == id_use_get_attrs(e2.data.ident.idu);
+    case expr_number:
+	return e1.data.number.value == e2.data.number.value;
+    default:
+	return false;
+    }
+}
+
+// Return true if exp is the number n
+static bool is_number(expr_t exp, word_type n)
+{
+    return exp.expr_kind == expr_number && exp.data.number.value == n;
+}
+
+// Requires: both operands of exp are numbers
+// Put the value of exp in *result and return true,
+// unless evaluating exp would be an error (then return false).
+// (Arithmetic wraps around, as in the VM.)
+static bool fold_numbers(binary_op_expr_t exp, word_type *result)
+{
+    unsigned int v1 = (unsigned int) exp.expr1->data.number.value;
+    unsigned int v2 = (unsigned int) exp.expr2->data.number.value;
+    switch (exp.arith_op.code) {
+    case plussym:
+	*result = (word_type)(v1 + v2);
+	return true;
+    case minussym:
+	*result = (word_type)(v1 - v2);
+	return true;
+    case multsym:
+	*result = (word_type)(v1 * v2);
+	return true;
+    case divsym:
+	if (v2 == 0 || ((word_type)v1 == INT_MIN && (word_type)v2 == -1)) {
+	    return false;
+	}
+	*result = (word_type)v1 / (word_type)v2;
+	return true;
+    default:
+	bail_with_error("Unexpected arithOp (%d) in fold_numbers!",
+			exp.arith_op.code);
+	return false;
+    }
+}
+
+// Requires: the operands of exp have been folded
+// Return exp simplified, or exp itself if it cannot be
+static expr_t fold_binary(expr_t exp)
+{
+    binary_op_expr_t bin = exp.data.binary;
+    expr_t e1 = *(bin.expr1);
+    expr_t e2 = *(bin.expr2);
+    word_type result;
+    if (e1.expr_kind == expr_number && e2.expr_kind == expr_number) {
+	if (fold_numbers(bin, &result)) {
+	    return number_expr(exp.file_loc, result);
+	}
+	return exp;
+    }
+    switch (bin.arith_op.code) {
+    case plussym:
+	if (is_number(e2, 0)) {
+	    return e1;
+	} else if (is_number(e1, 0)) {
+	    return e2;
+	}
+	break;
+    case minussym:
+	if (is_number(e2, 0)) {
+	    return e1;
+	} else if (same_expr(e1, e2) && !has_division(e1)) {
+	    return number_expr(exp.file_loc, 0);
+	}
+	break;
+    case multsym:
+	if (is_number(e2, 1)) {
+	    return e1;
+	} else if (is_number(e1, 1)) {
+	    return e2;
+	} else if ((is_number(e1, 0) && !has_division(e2))
+		   || (is_number(e2, 0) && !has_division(e1))) {
+	    return number_expr(exp.file_loc, 0);
+	}
+	break;
+    case divsym:
+	if (is_number(e2, 1)) {
+	    return e1;
+	}
+	break;
+    default:
+	break;
+    }
+    return exp;
+}
+
+// Fold the constants in the expression exp
+// Return the modified AST
+expr_t const_fold_expr(expr_t exp)
+{
+    switch (exp.expr_kind) {
+    case expr_bin:
+	{
+	    *(exp.data.binary.expr1) = const_fold_expr(*(exp.data.binary.expr1));
+	    *(exp.data.binary.expr2) = const_fold_expr(*(exp.data.binary.expr2));
+	    expr_t ret = fold_binary(exp);
+	    nodes_removed += expr_size(exp) - expr_size(ret);
+	    return ret;
+	}
+    case expr_ident:
+	{
+	    assert(exp.data.ident.idu != NULL);
+	    id_attrs *attrs = id_use_get_attrs(exp.data.ident.idu);
+	    if (attrs->kind == constant_idk) {
+		return number_expr(exp.file_loc, attrs->value);
+	    }
+	    return exp;
+	}
+    case expr_number:
+	return exp;
+    default:
+	bail_with_error("Unexpected expr_kind_e (%d) in const_fold_expr!",
+			exp.expr_kind);
+	return exp;
+    }
+}
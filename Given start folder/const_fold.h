@@ -0,0 +1,41 @@
+/* $Id$ */
+// Constant folding and algebraic simplification of the expressions
+// in a (scope checked) program's AST, done before code generation:
+// uses of constants are replaced by their values,
+// binary expressions whose operands are both numbers are replaced
+// by their values (unless evaluating them would be an error,
+// e.g., a division by 0, which is left for the program to do),
+// and the identities x+0 = 0+x = x-0 = x*1 = 1*x = x/1 = x,
+// x*0 = 0*x = 0, and x-x = 0 are applied
+// (the last two only when x has no division, which could fail)
+#ifndef _CONST_FOLD_H
+#define _CONST_FOLD_H
+#include "ast.h"
+
+// Requires: prog has been scope checked
+// Fold the constants in (the expressions of) the given program AST
+// Return the modified AST
+extern block_t const_fold_program(block_t prog);
+
+// Return the number of AST nodes removed from the program
+// by the latest call of const_fold_program
+extern unsigned int const_fold_nodes_removed();
+
+// Fold the constants in the block blk, and its procedures
+// Return the modified AST
+extern block_t const_fold_block(block_t blk);
+
+// Fold the constants in the statement stmt
+// (and the statements inside it)
+// Return the modified AST
+extern stmt_t const_fold_stmt(stmt_t stmt);
+
+// Fold the constants in the condition cond
+// Return the modified AST
+extern condition_t const_fold_condition(condition_t cond);
+
+// Fold the constants in the expression exp
+// Return the modified AST
+extern expr_t const_fold_expr(expr_t exp);
+
+#endif
@@ -11,13 +11,46 @@
 #include "regname.h"
 #include "id_use.h"
 #include "literal_table.h"
+#include "source_map.h"
 #include "gen_code.h"
 
 
+// the map from the program's instructions to its statements
+static source_map_t *source_map = NULL;
+
+// are expressions evaluated in registers (instead of on the stack)?
+static bool register_exprs = false;
+
+// the registers that expressions are evaluated into,
+// when they are evaluated in registers
+static const reg_num_type expr_regs[] = {T0, T0+1, T0+2, T0+3, T0+4, T0+5,
+                                         T0+6, T7, S0, S0+1, S0+2, S0+3,
+                                         S0+4, S0+5, S0+6, S7};
+#define NUM_EXPR_REGS (sizeof(expr_regs) / sizeof(expr_regs[0]))
+
 // Initialize the code generator
 extern void gen_code_initialize(){
     literal_table_initialize();
+    if (source_map != NULL) {
+        source_map_destroy(source_map);
+    }
+    source_map = NULL;
+}
 
+// Set whether expressions are evaluated in registers
+// (see gen_code_expr_into), instead of on the runtime stack
+void gen_code_set_register_exprs(bool in_registers)
+{
+    register_exprs = in_registers;
+}
+
+// Return a lowercase name for the kind of statement k
+// (the keyword that starts it, or "assign")
+static const char *stmt_kind_string(stmt_kind_e k)
+{
+    static const char *kind_names[8] = {"assign", "call", "begin", "if",
+                                        "while", "read", "write", "skip"};
+    return kind_names[k];
 }
 
 static void gen_code_output_seq(BOFFILE bf, code_seq cs) {
@@ -42,7 +75,15 @@ static BOFHeader gen_code_program_header(code_seq main_cs) {
 // Generate code for prog into bf
 extern void gen_code_program(BOFFILE bf, block_t prog) { 
     
+    // the statements are added to the map as their code is generated
+    const char *source_name = strrchr(prog.file_loc->filename, '/');
+    source_map = source_map_create((source_name == NULL)
+                                   ? prog.file_loc->filename
+                                   : source_name + 1);
     code_seq main_cs = gen_code_block(prog);
+    for (code_seq cs = main_cs; !code_seq_is_empty(cs); cs = code_seq_rest(cs)) {
+        source_map_add_instr(source_map, code_seq_first(cs)->stmt);
+    }
     
     BOFHeader header = gen_code_program_header(main_cs);
     
@@ -59,6 +100,19 @@ extern void gen_code_program(BOFFILE bf, block_t prog) {
 
     bof_close(bf);
 }
+// Requires: gen_code_program has been called
+// Write the map from the addresses of the program's instructions
+// to its statements (see source_map.h) to the file named filename
+void gen_code_write_map(const char *filename)
+{
+    FILE *out = fopen(filename, "w");
+    if (out == NULL) {
+        bail_with_error("Cannot open %s for writing!", filename);
+    }
+    source_map_write(source_map, out);
+    fclose(out);
+}
+
 // Requires: bf if open for writing in binary
 // Generate code for the given AST
 code_seq gen_code_block(block_t blk) {
@@ -116,8 +170,7 @@ extern code_seq gen_code_const_defs(const_defs_t cdfs) {
 
 // Generate code for the const-def, cdf
 code_seq gen_code_const_def(const_def_t cdf) {
-    unsigned int global_offset = literal_table_lookup(cdf.number.text, cdf.number.value);
-    return code_seq_concat(code_seq_singleton(code_lw(GP, V0, global_offset)), code_push_reg_on_stack(V0));
+    return code_seq_concat(gen_code_literal(cdf.number, V0), code_push_reg_on_stack(V0));
 }
 
 // Generate code for the var_decls_t vds to out
@@ -193,54 +246,66 @@ extern void gen_code_proc_decl(proc_decl_t pd) {
 
 // END EXTRA CREDIT
 
-// Generate code for stmt
+// Generate code for stmt,
+// recording in the source map that the code not generated for
+// the statements inside it is stmt's
 extern code_seq gen_code_stmt(stmt_t stmt){
 
+    unsigned int num = source_map_add_stmt(source_map, stmt.file_loc->line,
+                                           stmt_kind_string(stmt.stmt_kind));
+    code_seq ret = code_seq_empty();
     switch (stmt.stmt_kind) {
     case assign_stmt:
-	return gen_code_assign_stmt(stmt.data.assign_stmt);
+	ret = gen_code_assign_stmt(stmt.data.assign_stmt);
 	break;
     // case call_stmt:
-    // return gen_code_call_stmt(stmt.data.call_stmt);
+    // ret = gen_code_call_stmt(stmt.data.call_stmt);
     // break;
     case begin_stmt:
-	return gen_code_begin_stmt(stmt.data.begin_stmt);
+	ret = gen_code_begin_stmt(stmt.data.begin_stmt);
 	break;
     case if_stmt:
-	return gen_code_if_stmt(stmt.data.if_stmt);
+	ret = gen_code_if_stmt(stmt.data.if_stmt);
 	break;
     case while_stmt:
-    return gen_code_while_stmt(stmt.data.while_stmt);
+    ret = gen_code_while_stmt(stmt.data.while_stmt);
     break;
     case read_stmt:
-	return gen_code_read_stmt(stmt.data.read_stmt);
+	ret = gen_code_read_stmt(stmt.data.read_stmt);
 	break;
     case write_stmt:
-	return gen_code_write_stmt(stmt.data.write_stmt);
+	ret = gen_code_write_stmt(stmt.data.write_stmt);
 	break;
     case skip_stmt:
-    return gen_code_skip_stmt(stmt.data.skip_stmt);
+    ret = gen_code_skip_stmt(stmt.data.skip_stmt);
     break;
     default:
 	bail_with_error("Call to gen_code_stmt with an AST that is not a statement!");
 	break;
     }
-    // The following can never execute, but this quiets gcc's warning
-    return code_seq_empty();
+    // the statements inside stmt have already marked their code
+    code_seq_set_stmt(ret, num);
+    return ret;
 
 }
 
 // Generate code for stmt
 code_seq gen_code_assign_stmt(assign_stmt_t stmt) {
 
-    code_seq ret = gen_code_expr(*(stmt.expr));
+    code_seq ret;
     unsigned int offset = id_use_get_attrs(stmt.idu)->offset_count;
 
     assert(stmt.idu != NULL);
     assert(id_use_get_attrs(stmt.idu) != NULL);
     assert(offset <= USHRT_MAX);
 
-    ret = code_seq_concat(ret, code_pop_stack_into_reg(V0));
+    if (register_exprs) {
+        ret = gen_code_expr_into(*(stmt.expr), 0);
+        ret = code_seq_add_to_end(ret, code_add(0, expr_regs[0], V0));
+    } else {
+        ret = gen_code_expr(*(stmt.expr));
+        ret = code_seq_concat(ret, code_pop_stack_into_reg(V0));
+    }
     ret = code_seq_concat(ret, code_compute_fp(T9, stmt.idu->levelsOutward));
     ret = code_seq_add_to_end(ret, code_sw(T9, V0, offset));
     return ret;
@@ -285,16 +350,15 @@ extern code_seq gen_code_stmts(stmts_t stmts) {
 // Generate code for the if-statement given by stmt
 code_seq gen_code_if_stmt(if_stmt_t stmt) {
 
-    code_seq ret = gen_code_condition(stmt.condition);
-
     code_seq thenstmt = gen_code_stmt(*(stmt.then_stmt));
     int thenlen = code_seq_size(thenstmt);
 
     code_seq elsestmt = gen_code_stmt(*(stmt.else_stmt));
     int elselen = code_seq_size(elsestmt);
-    
-    ret = code_seq_concat(ret, code_pop_stack_into_reg(V0));
-    ret = code_seq_add_to_end(ret, code_beq(V0, 0, thenlen + 1));
+
+    // when the condition is false, jump over the then part
+    // (and the jump at its end) to the else part
+    code_seq ret = gen_code_condition(stmt.condition, false, thenlen + 1);
     ret = code_seq_concat(ret, thenstmt);
     ret = code_seq_add_to_end(ret, code_beq(0, 0, elselen));
     ret = code_seq_concat(ret, elsestmt);
@@ -302,18 +366,23 @@ code_seq gen_code_if_stmt(if_stmt_t stmt) {
     return ret;
 }
 
-// Generate code for the if-statment given by stmt
+// Generate code for the while-statment given by stmt,
+// which tests its condition after the body, so each iteration
+// only executes the body and the condition's code
 code_seq gen_code_while_stmt(while_stmt_t stmt) { 
     
-    code_seq ret = gen_code_condition(stmt.condition);
     code_seq bodystmt = gen_code_stmt(*(stmt.body));
-
     int bodylen = code_seq_size(bodystmt);
 
-    ret = code_seq_concat(ret, code_pop_stack_into_reg(V0));
-    ret = code_seq_add_to_end(ret, code_beq(V0, 0, bodylen + 1));
+    // first jump over the body to the condition
+    code_seq ret = code_seq_singleton(code_beq(0, 0, bodylen));
     ret = code_seq_concat(ret, bodystmt);
-    ret = code_seq_add_to_end(ret, code_beq(0, 0, -code_seq_size(ret)));
+    // the condition's jump is its last instruction, so it is
+    // the whole condition and body back to the start of the body
+    code_seq cond = gen_code_condition(stmt.condition, true, 0);
+    int condlen = code_seq_size(cond);
+    code_seq_last(cond)->instr.immed.immed = -(bodylen + condlen);
+    ret = code_seq_concat(ret, cond);
     return ret;
 }
 
@@ -330,17 +399,21 @@ extern code_seq gen_code_read_stmt(read_stmt_t stmt) {
     assert(id_use_get_attrs(stmt.idu) != NULL);
     unsigned int offset_count = id_use_get_attrs(stmt.idu)->offset_count;
     assert(offset_count <= USHRT_MAX); // it has to fit!
-    ret = code_seq_add_to_end(ret,
-			      code_seq_singleton(code_sw(T9, V0, offset_count)));
+    ret = code_seq_add_to_end(ret, code_sw(T9, V0, offset_count));
     return ret;
 
 }
 
 // Generate code for the write statment given by stmt.
 extern code_seq gen_code_write_stmt(write_stmt_t stmt) {
-    code_seq ret = gen_code_expr(stmt.expr);
-    
-    ret = code_seq_concat(ret, code_pop_stack_into_reg(A0));
+    code_seq ret;
+    if (register_exprs) {
+        ret = gen_code_expr_into(stmt.expr, 0);
+        ret = code_seq_add_to_end(ret, code_add(0, expr_regs[0], A0));
+    } else {
+        ret = gen_code_expr(stmt.expr);
+        ret = code_seq_concat(ret, code_pop_stack_into_reg(A0));
+    }
 
     ret = code_seq_add_to_end(ret, code_pint());
     
@@ -353,104 +426,159 @@ extern code_seq gen_code_skip_stmt(skip_stmt_t stmt){
     return code_seq_empty();
 }
 
-// Requires: reg != T9
-// Generate code for cond, putting its truth value
-// on top of the runtime stack
-// and using V0 and AT as temporary registers
-// May modify HI,LO when executed
-extern code_seq gen_code_condition(condition_t cond){
+// Generate code for cond that jumps offset instructions
+// past its end when cond's truth value is jump_if,
+// and otherwise falls through (to the instruction after its end),
+// using V0 and AT as temporary registers
+// (the jump is always the last instruction of the code)
+// May also modify SP, HI,LO when executed
+extern code_seq gen_code_condition(condition_t cond, bool jump_if,
+                                   int offset){
     code_seq ret;
 
     // Depending on the condition kind, call the appropriate function
     switch (cond.cond_kind) {
         case ck_odd:
             // Generate code for odd condition
-            ret = gen_code_odd_condition(cond.data.odd_cond);
+            ret = gen_code_odd_condition(cond.data.odd_cond, jump_if, offset);
             break;
         case ck_rel:
             // Generate code for relational operator condition
-            ret = gen_code_rel_op_condition(cond.data.rel_op_cond);
+            ret = gen_code_rel_op_condition(cond.data.rel_op_cond,
+                                            jump_if, offset);
             break;
         default:
             bail_with_error("Unknown condition kind (%d) in gen_code_condition!", cond.cond_kind);
             break;
     }
 
-    // The result of evaluating the condition should now be on top of the stack
     return ret;
 }
 
-// Generate code for cond, putting its truth value
-// on top of the runtime stack
-// and using V0 and AT as temporary registers
-// Modifies SP, HI,LO when executed
-extern code_seq gen_code_odd_condition(odd_condition_t cond){
-    code_seq ret = gen_code_expr(cond.expr);
-    ret = code_seq_concat(ret, code_pop_stack_into_reg(V0));
-    ret = code_seq_add_to_end(ret, code_andi(V0, V0, 1)); // V0 = V0 & 1 (to check if odd)
-    ret = code_seq_concat(ret, code_push_reg_on_stack(V0));
+// Generate code for cond that jumps offset instructions
+// past its end when cond's truth value is jump_if,
+// and otherwise falls through,
+// using V0 and AT as temporary registers
+// May also modify SP, HI,LO when executed
+extern code_seq gen_code_odd_condition(odd_condition_t cond, bool jump_if,
+                                       int offset){
+    code_seq ret;
+    reg_num_type r;
+    if (register_exprs) {
+        ret = gen_code_expr_into(cond.expr, 0);
+        r = expr_regs[0];
+    } else {
+        ret = gen_code_expr(cond.expr);
+        ret = code_seq_concat(ret, code_pop_stack_into_reg(V0));
+        r = V0;
+    }
+    ret = code_seq_add_to_end(ret, code_andi(r, V0, 1)); // V0 = r & 1 (to check if odd)
+    if (jump_if) {
+        ret = code_seq_add_to_end(ret, code_bne(V0, 0, offset));
+    } else {
+        ret = code_seq_add_to_end(ret, code_beq(V0, 0, offset));
+    }
     return ret;
 }
 
-// Generate code for cond, putting its truth value
-// on top of the runtime stack
-// and using V0 and AT as temporary registers
+// Generate code for cond that jumps offset instructions
+// past its end when cond's truth value is jump_if,
+// and otherwise falls through,
+// using V0 and AT as temporary registers
 // May also modify SP, HI,LO when executed
-code_seq gen_code_rel_op_condition(rel_op_condition_t cond) {
-    code_seq ret = code_seq_empty();
-    ret = code_seq_concat(ret, gen_code_expr(cond.expr1));
+code_seq gen_code_rel_op_condition(rel_op_condition_t cond, bool jump_if,
+                                   int offset) {
+    if (register_exprs) {
+        reg_num_type r1, r2;
+        code_seq ret = gen_code_operands_into(cond.expr1, cond.expr2, 0,
+                                              &r1, &r2);
+        return code_seq_concat(ret, gen_code_rel_op_jump(cond.rel_op, r1, r2,
+                                                         jump_if, offset));
+    }
+    code_seq ret = gen_code_expr(cond.expr1);
     ret = code_seq_concat(ret, gen_code_expr(cond.expr2));
-    ret = code_seq_concat(ret, gen_code_rel_op(cond.rel_op));
+    ret = code_seq_concat(ret, gen_code_rel_op(cond.rel_op, jump_if, offset));
     return ret;
 }
 
 // Generate code for the rel_op
 // applied to 2nd from top and top of the stack,
-// putting the result on top of the stack in their place,
-// and using V0 and AT as temporary registers
-// May also modify SP, HI,LO when executed
-extern code_seq gen_code_rel_op(token_t rel_op) {
+// popping them both, and then jumping offset instructions
+// past the end of the code if the result is jump_if,
+// using V0 and AT as temporary registers
+// May also modify SP when executed
+extern code_seq gen_code_rel_op(token_t rel_op, bool jump_if, int offset) {
     // load top of the stack (the second operand) into AT
     code_seq ret = code_pop_stack_into_reg(AT);
     // load next element of the stack into V0
     ret = code_seq_concat(ret, code_pop_stack_into_reg(V0));
+    return code_seq_concat(ret, gen_code_rel_op_jump(rel_op, V0, AT,
+                                                     jump_if, offset));
+}
 
-    // start out by doing the comparison
-    // and skipping the next 2 instructions if it's true
-    code_seq do_op = code_seq_empty();
-    switch (rel_op.code) {
+// Return the code of the relational operator that is the negation
+// of the one whose code is rel_op_code
+static int negated_rel_op(int rel_op_code)
+{
+    switch (rel_op_code) {
+    case eqsym:
+        return neqsym;
+    case neqsym:
+        return eqsym;
+    case ltsym:
+        return geqsym;
+    case leqsym:
+        return gtsym;
+    case gtsym:
+        return leqsym;
+    case geqsym:
+        return ltsym;
+    default:
+        bail_with_error("Unknown token code (%d) in negated_rel_op",
+                        rel_op_code);
+        break;
+    }
+    // never happens, but suppresses a warning from gcc
+    return rel_op_code;
+}
+
+// Generate code that applies rel_op to the registers r1 and r2
+// (in that order) and jumps offset instructions past the end
+// of the code if the result is jump_if (and otherwise falls through),
+// using V0 as a temporary register
+// (the jump is always the last instruction of the code)
+extern code_seq gen_code_rel_op_jump(token_t rel_op,
+                                     reg_num_type r1, reg_num_type r2,
+                                     bool jump_if, int offset) {
+    int op = jump_if ? rel_op.code : negated_rel_op(rel_op.code);
+    code_seq ret = code_seq_empty();
+    if (op != eqsym && op != neqsym) {
+        // the others compare r1 - r2 to 0
+        ret = code_seq_add_to_end(ret, code_sub(r1, r2, V0));
+    }
+    switch (op) {
         case eqsym:
-            do_op = code_seq_singleton(code_beq(V0, AT, 2));
+            ret = code_seq_add_to_end(ret, code_beq(r1, r2, offset));
             break;
         case neqsym:
-            do_op = code_seq_singleton(code_bne(V0, AT, 2));
+            ret = code_seq_add_to_end(ret, code_bne(r1, r2, offset));
             break;
         case ltsym:
-            do_op = code_seq_singleton(code_sub(V0, AT, V0));
-            do_op = code_seq_add_to_end(do_op, code_bltz(V0, 2));
+            ret = code_seq_add_to_end(ret, code_bltz(V0, offset));
             break;
         case leqsym:
-            do_op = code_seq_singleton(code_sub(V0, AT, V0));
-            do_op = code_seq_add_to_end(do_op, code_blez(V0, 2));
+            ret = code_seq_add_to_end(ret, code_blez(V0, offset));
             break;
         case gtsym:
-            do_op = code_seq_singleton(code_sub(V0, AT, V0));
-            do_op = code_seq_add_to_end(do_op, code_bgtz(V0, 2));
+            ret = code_seq_add_to_end(ret, code_bgtz(V0, offset));
             break;
         case geqsym:
-            do_op = code_seq_singleton(code_sub(V0, AT, V0));
-            do_op = code_seq_add_to_end(do_op, code_bgez(V0, 2));
+            ret = code_seq_add_to_end(ret, code_bgez(V0, offset));
             break;
         default:
-            bail_with_error("Unknown token code (%d) in gen_code_rel_op", rel_op.code);
+            bail_with_error("Unknown token code (%d) in gen_code_rel_op_jump", op);
             break;
     }
-    ret = code_seq_concat(ret, do_op);
-    // rest of the code for the comparisons
-    ret = code_seq_add_to_end(ret, code_addi(AT, 0, 0)); // put false in AT
-    ret = code_seq_add_to_end(ret, code_beq(0, 0, 1)); // skip next instr
-    ret = code_seq_add_to_end(ret, code_addi(AT, 0, 1)); // put true in AT
-    ret = code_seq_concat(ret, code_push_reg_on_stack(AT));
     return ret;
 }
 
@@ -545,7 +673,7 @@ extern code_seq gen_code_ident(ident_t id) {
     unsigned int offset_count = id_use_get_attrs(id.idu)->offset_count;
     assert(offset_count <= USHRT_MAX); // it has to fit!
 
-    ret = code_seq_add_to_end(ret, code_lw(T9, V0, offset_count * BYTES_PER_WORD));
+    ret = code_seq_add_to_end(ret, code_lw(T9, V0, offset_count));
 
     ret = code_seq_concat(ret, code_push_reg_on_stack(V0));
     return ret;
@@ -555,8 +683,136 @@ extern code_seq gen_code_ident(ident_t id) {
 // Generate code to put the given number on top of the stack
 extern code_seq gen_code_number(number_t num) {
 
-    unsigned int global_offset = literal_table_lookup(num.text, num.value);
-    return code_seq_concat(code_seq_singleton(code_lw(GP, V0, global_offset)), code_push_reg_on_stack(V0));
+    return code_seq_concat(gen_code_literal(num, V0), code_push_reg_on_stack(V0));
+
+}
 
+// Generate code to put the value of num in register r:
+// with one instruction if it fits in an immediate
+// (addi sign extends its immediate, and bori zero extends it),
+// and otherwise by loading it from the literal table,
+// which is also one instruction
+// (so only the numbers that need it are in the table)
+extern code_seq gen_code_literal(number_t num, reg_num_type r) {
+    word_type value = num.value;
+    if (SHRT_MIN <= value && value <= SHRT_MAX) {
+        return code_seq_singleton(code_addi(0, r, (immediate_type) value));
+    } else if (0 <= value && value <= USHRT_MAX) {
+        return code_seq_singleton(code_bori(0, r, (immediate_type) value));
+    }
+    unsigned int global_offset = literal_table_lookup(num.text, value);
+    return code_seq_singleton(code_lw(GP, r, global_offset));
+}
+
+// Return the number of registers needed to evaluate exp
+// without spilling (its Sethi-Ullman number)
+static unsigned int expr_regs_needed(expr_t exp)
+{
+    if (exp.expr_kind != expr_bin) {
+        return 1;
+    }
+    unsigned int n1 = expr_regs_needed(*(exp.data.binary.expr1));
+    unsigned int n2 = expr_regs_needed(*(exp.data.binary.expr2));
+    return (n1 == n2) ? n1 + 1 : MAX(n1, n2);
+}
+
+// Requires: k < NUM_EXPR_REGS
+// Generate code to evaluate e1 and e2, putting their values
+// in the registers *r1 and *r2: one of those is expr_regs[k], and
+// the other is expr_regs[k+1], or AT if there are not enough registers.
+// The operand that needs more registers is evaluated first
+// (as their evaluation order does not matter), so the other can use
+// all but the one holding its value; when both need more registers
+// than are left from expr_regs[k] on, the first one's value is spilled
+// onto the stack while the second is evaluated
+// May also modify expr_regs[k] on, V0, AT, T9, SP, HI, and LO when executed
+extern code_seq gen_code_operands_into(expr_t e1, expr_t e2, unsigned int k,
+                                       reg_num_type *r1, reg_num_type *r2)
+{
+    assert(k < NUM_EXPR_REGS);
+    unsigned int n1 = expr_regs_needed(e1);
+    unsigned int n2 = expr_regs_needed(e2);
+    unsigned int left = NUM_EXPR_REGS - k;
+    code_seq ret;
+    if (n1 >= left && n2 >= left) {
+        ret = gen_code_expr_into(e1, k);
+        ret = code_seq_concat(ret, code_push_reg_on_stack(expr_regs[k]));
+        ret = code_seq_concat(ret, gen_code_expr_into(e2, k));
+        ret = code_seq_concat(ret, code_pop_stack_into_reg(AT));
+        *r1 = AT;
+        *r2 = expr_regs[k];
+    } else if (n1 >= n2) {
+        ret = gen_code_expr_into(e1, k);
+        ret = code_seq_concat(ret, gen_code_expr_into(e2, k + 1));
+        *r1 = expr_regs[k];
+        *r2 = expr_regs[k + 1];
+    } else {
+        ret = gen_code_expr_into(e2, k);
+        ret = code_seq_concat(ret, gen_code_expr_into(e1, k + 1));
+        *r1 = expr_regs[k + 1];
+        *r2 = expr_regs[k];
+    }
+    return ret;
 }
 
+// Requires: k < NUM_EXPR_REGS
+// Generate code for the expression exp,
+// putting its value in register expr_regs[k],
+// and using the registers after it as temporary registers
+// (spilling onto the stack only when they run out)
+// May also modify expr_regs[k] on, V0, AT, T9, SP, HI, and LO when executed
+extern code_seq gen_code_expr_into(expr_t exp, unsigned int k) {
+    reg_num_type rk = expr_regs[k];
+    code_seq ret = code_seq_empty();
+    switch (exp.expr_kind) {
+    case expr_bin:
+        {
+            binary_op_expr_t bin = exp.data.binary;
+            reg_num_type r1, r2;
+            ret = gen_code_operands_into(*(bin.expr1), *(bin.expr2), k,
+                                         &r1, &r2);
+            switch (bin.arith_op.code) {
+            case plussym:
+                ret = code_seq_add_to_end(ret, code_add(r1, r2, rk));
+                break;
+            case minussym:
+                ret = code_seq_add_to_end(ret, code_sub(r1, r2, rk));
+                break;
+            case multsym:
+                ret = code_seq_add_to_end(ret, code_mul(r1, r2));
+                ret = code_seq_add_to_end(ret, code_mflo(rk));
+                break;
+            case divsym:
+                ret = code_seq_add_to_end(ret, code_div(r1, r2));
+                ret = code_seq_add_to_end(ret, code_mflo(rk));
+                break;
+            default:
+                bail_with_error("Unexpected arithOp (%d) in gen_code_expr_into",
+                                bin.arith_op.code);
+                break;
+            }
+        }
+        break;
+    case expr_ident:
+        {
+            ident_t id = exp.data.ident;
+            assert(id.idu != NULL);
+            ret = code_compute_fp(T9, id.idu->levelsOutward);
+            assert(id_use_get_attrs(id.idu) != NULL);
+            unsigned int offset_count = id_use_get_attrs(id.idu)->offset_count;
+            assert(offset_count <= USHRT_MAX); // it has to fit!
+            ret = code_seq_add_to_end(ret, code_lw(T9, rk, offset_count));
+        }
+        break;
+    case expr_number:
+        {
+            ret = gen_code_literal(exp.data.number, rk);
+        }
+        break;
+    default:
+        bail_with_error("Unexpected expr_kind_e (%d) in gen_code_expr_into",
+                        exp.expr_kind);
+        break;
+    }
+    return ret;
+}
@@ -11,10 +11,20 @@
 // Initialize the code generator
 extern void gen_code_initialize();
 
+// Set whether expressions are evaluated in registers
+// (see gen_code_expr_into), instead of on the runtime stack
+// (the default)
+extern void gen_code_set_register_exprs(bool in_registers);
+
 // Requires: bf if open for writing in binary
 // Generate code for prog into bf
 extern void gen_code_program(BOFFILE bf, block_t prog);
 
+// Requires: gen_code_program has been called
+// Write the map from the addresses of the program's instructions
+// to its statements (see source_map.h) to the file named filename
+extern void gen_code_write_map(const char *filename);
+
 // Requires: bf if open for writing in binary
 // Generate code for the given AST
 extern code_seq gen_code_block(block_t blk);
@@ -55,7 +65,9 @@ extern void gen_code_proc_decls(proc_decls_t pds);
 // (Stub for:) Generate code for a procedure declaration
 extern void gen_code_proc_decl(proc_decl_t pd);
 
-// Generate code for stmt
+// Generate code for stmt,
+// recording in the source map that the code not generated for
+// the statements inside it is stmt's
 extern code_seq gen_code_stmt(stmt_t stmt);
 
 // Generate code for stmt
@@ -85,30 +97,47 @@ extern code_seq gen_code_write_stmt(write_stmt_t stmt);
 // Generate code for the skip statment, stmt
 extern code_seq gen_code_skip_stmt(skip_stmt_t stmt);
 
-// Generate code for cond, putting its truth value
-// on top of the runtime stack
-// and using V0 and AT as temporary registers
-// May modify HI,LO when executed
-extern code_seq gen_code_condition(condition_t cond);
+// Generate code for cond that jumps offset instructions
+// past its end when cond's truth value is jump_if,
+// and otherwise falls through (to the instruction after its end),
+// using V0 and AT as temporary registers
+// (the jump is always the last instruction of the code)
+// May also modify SP, HI,LO when executed
+extern code_seq gen_code_condition(condition_t cond, bool jump_if,
+                                   int offset);
 
-// Generate code for cond, putting its truth value
-// on top of the runtime stack
-// and using V0 and AT as temporary registers
-// Modifies SP, HI,LO when executed
-extern code_seq gen_code_odd_condition(odd_condition_t cond);
+// Generate code for cond that jumps offset instructions
+// past its end when cond's truth value is jump_if,
+// and otherwise falls through,
+// using V0 and AT as temporary registers
+// May also modify SP, HI,LO when executed
+extern code_seq gen_code_odd_condition(odd_condition_t cond, bool jump_if,
+                                       int offset);
 
-// Generate code for cond, putting its truth value
-// on top of the runtime stack
-// and using V0 and AT as temporary registers
+// Generate code for cond that jumps offset instructions
+// past its end when cond's truth value is jump_if,
+// and otherwise falls through,
+// using V0 and AT as temporary registers
 // May also modify SP, HI,LO when executed
-extern code_seq gen_code_rel_op_condition(rel_op_condition_t cond);
+extern code_seq gen_code_rel_op_condition(rel_op_condition_t cond,
+                                          bool jump_if, int offset);
 
 // Generate code for the rel_op
 // applied to 2nd from top and top of the stack,
-// putting the result on top of the stack in their place,
-// and using V0 and AT as temporary registers
-// May also modify SP, HI,LO when executed
-extern code_seq gen_code_rel_op(token_t rel_op);
+// popping them both, and then jumping offset instructions
+// past the end of the code if the result is jump_if,
+// using V0 and AT as temporary registers
+// May also modify SP when executed
+extern code_seq gen_code_rel_op(token_t rel_op, bool jump_if, int offset);
+
+// Generate code that applies rel_op to the registers r1 and r2
+// (in that order) and jumps offset instructions past the end
+// of the code if the result is jump_if (and otherwise falls through),
+// using V0 as a temporary register
+// (the jump is always the last instruction of the code)
+extern code_seq gen_code_rel_op_jump(token_t rel_op,
+                                     reg_num_type r1, reg_num_type r2,
+                                     bool jump_if, int offset);
 
 // Generate code for the expression exp
 // putting the result on top of the stack,
@@ -137,4 +166,34 @@ extern code_seq gen_code_ident(ident_t id);
 // Generate code to put the given number on top of the stack
 extern code_seq gen_code_number(number_t num);
 
+// Generate code to put the value of num in register r:
+// with one instruction if it fits in an immediate
+// (addi sign extends its immediate, and bori zero extends it),
+// with two if it is such an immediate shifted left,
+// and otherwise by loading it from the literal table
+// (so only the numbers that need it are in the table)
+extern code_seq gen_code_literal(number_t num, reg_num_type r);
+
+// Requires: k < NUM_EXPR_REGS
+// Generate code to evaluate e1 and e2, putting their values
+// in the registers *r1 and *r2: one of those is expr_regs[k], and
+// the other is expr_regs[k+1], or AT if there are not enough registers.
+// The operand that needs more registers is evaluated first
+// (as their evaluation order does not matter), so the other can use
+// all but the one holding its value; when both need more registers
+// than are left from expr_regs[k] on, the first one's value is spilled
+// onto the stack while the second is evaluated
+// May also modify expr_regs[k] on, V0, AT, T9, SP, HI, and LO when executed
+extern code_seq gen_code_operands_into(expr_t e1, expr_t e2, unsigned int k,
+                                       reg_num_type *r1, reg_num_type *r2);
+
+// Requires: k < NUM_EXPR_REGS
+// Generate code for the expression exp,
+// putting its value in register expr_regs[k]
+// (where expr_regs is $t0 to $t7, then $s0 to $s7),
+// and using the registers after it as temporary registers
+// (spilling onto the stack only when they run out)
+// May also modify expr_regs[k] on, V0, AT, T9, SP, HI, and LO when executed
+extern code_seq gen_code_expr_into(expr_t exp, unsigned int k);
+
 #endif
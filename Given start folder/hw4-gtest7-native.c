@@ -0,0 +1,254 @@
+/* Generated by bof2c from ../hw4-gtest7.bof; do not edit */
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MEMORY_SIZE_IN_BYTES 65532
+#define MEMORY_SIZE_IN_WORDS 16383
+
+// the SRM's memory, holding the program's text and data
+static union {
+    unsigned char bytes[MEMORY_SIZE_IN_BYTES];
+    int words[MEMORY_SIZE_IN_WORDS];
+} memory = { .words = {
+    [0] = -200887,
+    [1] = 1899,
+    [2] = -200887,
+    [3] = 1899,
+    [4] = -4245,
+    [5] = -67733,
+    [6] = -2078349312,
+    [7] = -3084471,
+    [8] = -186453,
+    [9] = -196693,
+    [10] = -292949,
+    [11] = -356437,
+    [12] = -419925,
+    [13] = -483413,
+    [14] = -546901,
+    [15] = -610389,
+    [16] = -673877,
+    [17] = -737365,
+    [18] = -192503,
+    [19] = -200887,
+    [20] = 5995,
+    [21] = 5987,
+    [22] = 323401,
+    [23] = -2078674944,
+    [24] = 5739,
+    [25] = 266249,
+    [26] = -200887,
+    [27] = 5995,
+    [28] = 5987,
+    [29] = 323401,
+    [30] = -2078674944,
+    [31] = 71275,
+    [32] = -2078674944,
+    [33] = 71267,
+    [34] = -200887,
+    [35] = 5995,
+    [36] = 10083,
+    [37] = 323401,
+    [38] = 805306688,
+    [39] = -2078674944,
+    [40] = 5731,
+    [41] = -200887,
+    [42] = 5995,
+    [43] = 5987,
+    [44] = 323401,
+    [45] = -2078674944,
+    [46] = 71275,
+    [47] = -2078674944,
+    [48] = 71267,
+    [49] = -200887,
+    [50] = 5995,
+    [51] = 10083,
+    [52] = 323401,
+    [53] = 805306688,
+    [54] = -196701,
+    [55] = -292957,
+    [56] = -356445,
+    [57] = -419933,
+    [58] = -483421,
+    [59] = -546909,
+    [60] = -610397,
+    [61] = -673885,
+    [62] = -737373,
+    [63] = -4189,
+    [64] = -67677,
+    [65] = 61257,
+    [66] = 805307008,
+} };
+
+// Print msg and a newline on stderr, as the VM does, and exit with a failure code
+static void bail(const char *msg)
+{
+    fflush(stdout);
+    fprintf(stderr, "%s\n", msg);
+    exit(EXIT_FAILURE);
+}
+
+int main()
+{
+    int r0 = 0; // $0
+    int r2 = 0; // $v0
+    int r4 = 5392; // $a0
+    int r16 = 0; // $s0
+    int r17 = 0; // $s1
+    int r18 = 0; // $s2
+    int r19 = 0; // $s3
+    int r20 = 0; // $s4
+    int r21 = 0; // $s5
+    int r22 = 0; // $s6
+    int r23 = 0; // $s7
+    int r25 = 0; // $t9
+    int r29 = 5392; // $sp
+    int r30 = 5392; // $fp
+    int r31 = 0; // $ra
+    unsigned int pc;
+
+    pc = 0;
+    goto dispatch;
+ a0:	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// SW $sp, $sp, -1	# offset is -4 bytes
+	memory.words[(unsigned)((r29 + -4) / 4)] = r29;
+	// SW $sp, $fp, -2	# offset is -8 bytes
+	memory.words[(unsigned)((r29 + -8) / 4)] = r30;
+	// ADD $0, $sp, $fp
+	r30 = (int)((unsigned)r0 + (unsigned)r29);
+	// ADDI $sp, $sp, -48
+	r29 = (int)((unsigned)r29 + (unsigned)-48);
+	// SW $fp, $a0, -3	# offset is -12 bytes
+	memory.words[(unsigned)((r30 + -12) / 4)] = r4;
+	// SW $fp, $ra, -4	# offset is -16 bytes
+	memory.words[(unsigned)((r30 + -16) / 4)] = r31;
+	// SW $fp, $s0, -5	# offset is -20 bytes
+	memory.words[(unsigned)((r30 + -20) / 4)] = r16;
+	// SW $fp, $s1, -6	# offset is -24 bytes
+	memory.words[(unsigned)((r30 + -24) / 4)] = r17;
+	// SW $fp, $s2, -7	# offset is -28 bytes
+	memory.words[(unsigned)((r30 + -28) / 4)] = r18;
+	// SW $fp, $s3, -8	# offset is -32 bytes
+	memory.words[(unsigned)((r30 + -32) / 4)] = r19;
+	// SW $fp, $s4, -9	# offset is -36 bytes
+	memory.words[(unsigned)((r30 + -36) / 4)] = r20;
+	// SW $fp, $s5, -10	# offset is -40 bytes
+	memory.words[(unsigned)((r30 + -40) / 4)] = r21;
+	// SW $fp, $s6, -11	# offset is -44 bytes
+	memory.words[(unsigned)((r30 + -44) / 4)] = r22;
+	// SW $fp, $s7, -12	# offset is -48 bytes
+	memory.words[(unsigned)((r30 + -48) / 4)] = r23;
+	// ADDI $0, $v0, -3
+	r2 = (int)((unsigned)r0 + (unsigned)-3);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r25 + 0) / 4)] = r2;
+	// ADDI $0, $v0, 4
+	r2 = (int)((unsigned)r0 + (unsigned)4);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 1	# offset is +4 bytes
+	memory.words[(unsigned)((r25 + 4) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 1	# offset is +4 bytes
+	r2 = memory.words[(unsigned)((r25 + 4) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r25 + 0) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 1	# offset is +4 bytes
+	memory.words[(unsigned)((r25 + 4) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 1	# offset is +4 bytes
+	r2 = memory.words[(unsigned)((r25 + 4) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// LW $fp, $ra, -4	# offset is -16 bytes
+	r31 = memory.words[(unsigned)((r30 + -16) / 4)];
+	// LW $fp, $s0, -5	# offset is -20 bytes
+	r16 = memory.words[(unsigned)((r30 + -20) / 4)];
+	// LW $fp, $s1, -6	# offset is -24 bytes
+	r17 = memory.words[(unsigned)((r30 + -24) / 4)];
+	// LW $fp, $s2, -7	# offset is -28 bytes
+	r18 = memory.words[(unsigned)((r30 + -28) / 4)];
+	// LW $fp, $s3, -8	# offset is -32 bytes
+	r19 = memory.words[(unsigned)((r30 + -32) / 4)];
+	// LW $fp, $s4, -9	# offset is -36 bytes
+	r20 = memory.words[(unsigned)((r30 + -36) / 4)];
+	// LW $fp, $s5, -10	# offset is -40 bytes
+	r21 = memory.words[(unsigned)((r30 + -40) / 4)];
+	// LW $fp, $s6, -11	# offset is -44 bytes
+	r22 = memory.words[(unsigned)((r30 + -44) / 4)];
+	// LW $fp, $s7, -12	# offset is -48 bytes
+	r23 = memory.words[(unsigned)((r30 + -48) / 4)];
+	// LW $fp, $sp, -1	# offset is -4 bytes
+	r29 = memory.words[(unsigned)((r30 + -4) / 4)];
+	// LW $fp, $fp, -2	# offset is -8 bytes
+	r30 = memory.words[(unsigned)((r30 + -8) / 4)];
+	// ADDI $sp, $sp, 0
+	r29 = (int)((unsigned)r29 + (unsigned)0);
+	// EXIT 
+	exit(0);
+	pc = 268;
+ dispatch:
+    switch (pc) {
+    case 0: goto a0;
+    default:
+	fprintf(stderr, "bof2c: no code for address %u\n", pc);
+	bail("(only addresses of labels can be jumped to)");
+    }
+    return EXIT_SUCCESS;
+}
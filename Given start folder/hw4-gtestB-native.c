@@ -0,0 +1,374 @@
+/* Generated by bof2c from ../hw4-gtestB.bof; do not edit */
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MEMORY_SIZE_IN_BYTES 65532
+#define MEMORY_SIZE_IN_WORDS 16383
+
+// the SRM's memory, holding the program's text and data
+static union {
+    unsigned char bytes[MEMORY_SIZE_IN_BYTES];
+    int words[MEMORY_SIZE_IN_WORDS];
+} memory = { .words = {
+    [0] = -200887,
+    [1] = 1899,
+    [2] = -200887,
+    [3] = 1899,
+    [4] = -200887,
+    [5] = 1899,
+    [6] = -200887,
+    [7] = 1899,
+    [8] = 200713,
+    [9] = -200887,
+    [10] = 5995,
+    [11] = 135177,
+    [12] = -200887,
+    [13] = 5995,
+    [14] = 69641,
+    [15] = -200887,
+    [16] = 5995,
+    [17] = 4105,
+    [18] = -200887,
+    [19] = 5995,
+    [20] = -4245,
+    [21] = -67733,
+    [22] = -2078349312,
+    [23] = -3084471,
+    [24] = -186453,
+    [25] = -196693,
+    [26] = -292949,
+    [27] = -356437,
+    [28] = -419925,
+    [29] = -483413,
+    [30] = -546901,
+    [31] = -610389,
+    [32] = -673877,
+    [33] = -737365,
+    [34] = 4105,
+    [35] = -200887,
+    [36] = 5995,
+    [37] = 10083,
+    [38] = 323401,
+    [39] = 805306688,
+    [40] = 69641,
+    [41] = -200887,
+    [42] = 5995,
+    [43] = 10083,
+    [44] = 323401,
+    [45] = 805306688,
+    [46] = 135177,
+    [47] = -200887,
+    [48] = 5995,
+    [49] = 10083,
+    [50] = 323401,
+    [51] = 805306688,
+    [52] = 69641,
+    [53] = -200887,
+    [54] = 5995,
+    [55] = 5987,
+    [56] = 323401,
+    [57] = -2078674944,
+    [58] = 267883,
+    [59] = -2078674944,
+    [60] = 267875,
+    [61] = -200887,
+    [62] = 5995,
+    [63] = 10083,
+    [64] = 323401,
+    [65] = 805306688,
+    [66] = 135177,
+    [67] = -200887,
+    [68] = 5995,
+    [69] = 5987,
+    [70] = 323401,
+    [71] = -2078674944,
+    [72] = 333419,
+    [73] = -2078674944,
+    [74] = 333411,
+    [75] = -200887,
+    [76] = 5995,
+    [77] = 10083,
+    [78] = 323401,
+    [79] = 805306688,
+    [80] = 200713,
+    [81] = -200887,
+    [82] = 5995,
+    [83] = 5987,
+    [84] = 323401,
+    [85] = -2078674944,
+    [86] = 398955,
+    [87] = -2078674944,
+    [88] = 398947,
+    [89] = -200887,
+    [90] = 5995,
+    [91] = 10083,
+    [92] = 323401,
+    [93] = 805306688,
+    [94] = -196701,
+    [95] = -292957,
+    [96] = -356445,
+    [97] = -419933,
+    [98] = -483421,
+    [99] = -546909,
+    [100] = -610397,
+    [101] = -673885,
+    [102] = -737373,
+    [103] = -4189,
+    [104] = -67677,
+    [105] = 61257,
+    [106] = 805307008,
+} };
+
+// Print msg and a newline on stderr, as the VM does, and exit with a failure code
+static void bail(const char *msg)
+{
+    fflush(stdout);
+    fprintf(stderr, "%s\n", msg);
+    exit(EXIT_FAILURE);
+}
+
+int main()
+{
+    int r0 = 0; // $0
+    int r2 = 0; // $v0
+    int r4 = 5552; // $a0
+    int r16 = 0; // $s0
+    int r17 = 0; // $s1
+    int r18 = 0; // $s2
+    int r19 = 0; // $s3
+    int r20 = 0; // $s4
+    int r21 = 0; // $s5
+    int r22 = 0; // $s6
+    int r23 = 0; // $s7
+    int r25 = 0; // $t9
+    int r29 = 5552; // $sp
+    int r30 = 5552; // $fp
+    int r31 = 0; // $ra
+    unsigned int pc;
+
+    pc = 0;
+    goto dispatch;
+ a0:	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $0, $v0, 3
+	r2 = (int)((unsigned)r0 + (unsigned)3);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADDI $0, $v0, 2
+	r2 = (int)((unsigned)r0 + (unsigned)2);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADDI $0, $v0, 1
+	r2 = (int)((unsigned)r0 + (unsigned)1);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADDI $0, $v0, 0
+	r2 = (int)((unsigned)r0 + (unsigned)0);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// SW $sp, $sp, -1	# offset is -4 bytes
+	memory.words[(unsigned)((r29 + -4) / 4)] = r29;
+	// SW $sp, $fp, -2	# offset is -8 bytes
+	memory.words[(unsigned)((r29 + -8) / 4)] = r30;
+	// ADD $0, $sp, $fp
+	r30 = (int)((unsigned)r0 + (unsigned)r29);
+	// ADDI $sp, $sp, -48
+	r29 = (int)((unsigned)r29 + (unsigned)-48);
+	// SW $fp, $a0, -3	# offset is -12 bytes
+	memory.words[(unsigned)((r30 + -12) / 4)] = r4;
+	// SW $fp, $ra, -4	# offset is -16 bytes
+	memory.words[(unsigned)((r30 + -16) / 4)] = r31;
+	// SW $fp, $s0, -5	# offset is -20 bytes
+	memory.words[(unsigned)((r30 + -20) / 4)] = r16;
+	// SW $fp, $s1, -6	# offset is -24 bytes
+	memory.words[(unsigned)((r30 + -24) / 4)] = r17;
+	// SW $fp, $s2, -7	# offset is -28 bytes
+	memory.words[(unsigned)((r30 + -28) / 4)] = r18;
+	// SW $fp, $s3, -8	# offset is -32 bytes
+	memory.words[(unsigned)((r30 + -32) / 4)] = r19;
+	// SW $fp, $s4, -9	# offset is -36 bytes
+	memory.words[(unsigned)((r30 + -36) / 4)] = r20;
+	// SW $fp, $s5, -10	# offset is -40 bytes
+	memory.words[(unsigned)((r30 + -40) / 4)] = r21;
+	// SW $fp, $s6, -11	# offset is -44 bytes
+	memory.words[(unsigned)((r30 + -44) / 4)] = r22;
+	// SW $fp, $s7, -12	# offset is -48 bytes
+	memory.words[(unsigned)((r30 + -48) / 4)] = r23;
+	// ADDI $0, $v0, 0
+	r2 = (int)((unsigned)r0 + (unsigned)0);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADDI $0, $v0, 1
+	r2 = (int)((unsigned)r0 + (unsigned)1);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADDI $0, $v0, 2
+	r2 = (int)((unsigned)r0 + (unsigned)2);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADDI $0, $v0, 1
+	r2 = (int)((unsigned)r0 + (unsigned)1);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 4	# offset is +16 bytes
+	memory.words[(unsigned)((r25 + 16) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 4	# offset is +16 bytes
+	r2 = memory.words[(unsigned)((r25 + 16) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADDI $0, $v0, 2
+	r2 = (int)((unsigned)r0 + (unsigned)2);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 5	# offset is +20 bytes
+	memory.words[(unsigned)((r25 + 20) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 5	# offset is +20 bytes
+	r2 = memory.words[(unsigned)((r25 + 20) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADDI $0, $v0, 3
+	r2 = (int)((unsigned)r0 + (unsigned)3);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 6	# offset is +24 bytes
+	memory.words[(unsigned)((r25 + 24) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 6	# offset is +24 bytes
+	r2 = memory.words[(unsigned)((r25 + 24) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// LW $fp, $ra, -4	# offset is -16 bytes
+	r31 = memory.words[(unsigned)((r30 + -16) / 4)];
+	// LW $fp, $s0, -5	# offset is -20 bytes
+	r16 = memory.words[(unsigned)((r30 + -20) / 4)];
+	// LW $fp, $s1, -6	# offset is -24 bytes
+	r17 = memory.words[(unsigned)((r30 + -24) / 4)];
+	// LW $fp, $s2, -7	# offset is -28 bytes
+	r18 = memory.words[(unsigned)((r30 + -28) / 4)];
+	// LW $fp, $s3, -8	# offset is -32 bytes
+	r19 = memory.words[(unsigned)((r30 + -32) / 4)];
+	// LW $fp, $s4, -9	# offset is -36 bytes
+	r20 = memory.words[(unsigned)((r30 + -36) / 4)];
+	// LW $fp, $s5, -10	# offset is -40 bytes
+	r21 = memory.words[(unsigned)((r30 + -40) / 4)];
+	// LW $fp, $s6, -11	# offset is -44 bytes
+	r22 = memory.words[(unsigned)((r30 + -44) / 4)];
+	// LW $fp, $s7, -12	# offset is -48 bytes
+	r23 = memory.words[(unsigned)((r30 + -48) / 4)];
+	// LW $fp, $sp, -1	# offset is -4 bytes
+	r29 = memory.words[(unsigned)((r30 + -4) / 4)];
+	// LW $fp, $fp, -2	# offset is -8 bytes
+	r30 = memory.words[(unsigned)((r30 + -8) / 4)];
+	// ADDI $sp, $sp, 0
+	r29 = (int)((unsigned)r29 + (unsigned)0);
+	// EXIT 
+	exit(0);
+	pc = 428;
+ dispatch:
+    switch (pc) {
+    case 0: goto a0;
+    default:
+	fprintf(stderr, "bof2c: no code for address %u\n", pc);
+	bail("(only addresses of labels can be jumped to)");
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1395 @@
+/* Generated by bof2c from ../hw4-gtestI.bof; do not edit */
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MEMORY_SIZE_IN_BYTES 65532
+#define MEMORY_SIZE_IN_WORDS 16383
+
+// the SRM's memory, holding the program's text and data
+static union {
+    unsigned char bytes[MEMORY_SIZE_IN_BYTES];
+    int words[MEMORY_SIZE_IN_WORDS];
+} memory = { .words = {
+    [0] = -200887,
+    [1] = 1899,
+    [2] = -200887,
+    [3] = 1899,
+    [4] = -200887,
+    [5] = 1899,
+    [6] = -200887,
+    [7] = 1899,
+    [8] = -200887,
+    [9] = 1899,
+    [10] = -200887,
+    [11] = 1899,
+    [12] = -200887,
+    [13] = 1899,
+    [14] = 135177,
+    [15] = -200887,
+    [16] = 5995,
+    [17] = 4105,
+    [18] = -200887,
+    [19] = 5995,
+    [20] = -4245,
+    [21] = -67733,
+    [22] = -2078349312,
+    [23] = -3084471,
+    [24] = -186453,
+    [25] = -196693,
+    [26] = -292949,
+    [27] = -356437,
+    [28] = -419925,
+    [29] = -483413,
+    [30] = -546901,
+    [31] = -610389,
+    [32] = -673877,
+    [33] = -737365,
+    [34] = 200713,
+    [35] = -200887,
+    [36] = 5995,
+    [37] = 5987,
+    [38] = 323401,
+    [39] = -2078674944,
+    [40] = 136811,
+    [41] = 266249,
+    [42] = -200887,
+    [43] = 5995,
+    [44] = 5987,
+    [45] = 323401,
+    [46] = -2078674944,
+    [47] = 530027,
+    [48] = -2078674944,
+    [49] = 202339,
+    [50] = -200887,
+    [51] = 5995,
+    [52] = 10083,
+    [53] = 323401,
+    [54] = 805306688,
+    [55] = -2078674944,
+    [56] = 136803,
+    [57] = -200887,
+    [58] = 5995,
+    [59] = -2078674944,
+    [60] = 398947,
+    [61] = -200887,
+    [62] = 5995,
+    [63] = 3939,
+    [64] = 323401,
+    [65] = 5987,
+    [66] = 323401,
+    [67] = -2080241536,
+    [68] = -200887,
+    [69] = 5995,
+    [70] = 5987,
+    [71] = 323401,
+    [72] = -2078674944,
+    [73] = 202347,
+    [74] = -2078674944,
+    [75] = 202339,
+    [76] = -200887,
+    [77] = 5995,
+    [78] = 10083,
+    [79] = 323401,
+    [80] = 805306688,
+    [81] = -2078674944,
+    [82] = 398947,
+    [83] = -200887,
+    [84] = 5995,
+    [85] = 10083,
+    [86] = 323401,
+    [87] = 805306688,
+    [88] = -2078674944,
+    [89] = 136803,
+    [90] = -200887,
+    [91] = 5995,
+    [92] = -2078674944,
+    [93] = 530019,
+    [94] = -200887,
+    [95] = 5995,
+    [96] = 3939,
+    [97] = 323401,
+    [98] = 5987,
+    [99] = 323401,
+    [100] = 526469,
+    [101] = -2078674944,
+    [102] = 136803,
+    [103] = -200887,
+    [104] = 5995,
+    [105] = 10083,
+    [106] = 323401,
+    [107] = 805306688,
+    [108] = 393220,
+    [109] = 4105,
+    [110] = -200887,
+    [111] = 5995,
+    [112] = 10083,
+    [113] = 323401,
+    [114] = 805306688,
+    [115] = -2078674944,
+    [116] = 136803,
+    [117] = -200887,
+    [118] = 5995,
+    [119] = -2078674944,
+    [120] = 530019,
+    [121] = -200887,
+    [122] = 5995,
+    [123] = 3939,
+    [124] = 323401,
+    [125] = 5987,
+    [126] = 323401,
+    [127] = 526468,
+    [128] = -2078674944,
+    [129] = 530019,
+    [130] = -200887,
+    [131] = 5995,
+    [132] = 10083,
+    [133] = 323401,
+    [134] = 805306688,
+    [135] = 393220,
+    [136] = 135177,
+    [137] = -200887,
+    [138] = 5995,
+    [139] = 10083,
+    [140] = 323401,
+    [141] = 805306688,
+    [142] = -2078674944,
+    [143] = 136803,
+    [144] = -200887,
+    [145] = 5995,
+    [146] = -2078674944,
+    [147] = 530019,
+    [148] = -200887,
+    [149] = 5995,
+    [150] = 3939,
+    [151] = 323401,
+    [152] = 5987,
+    [153] = 323401,
+    [154] = -1946023808,
+    [155] = 460929,
+    [156] = 7081993,
+    [157] = -200887,
+    [158] = 5995,
+    [159] = 10083,
+    [160] = 323401,
+    [161] = 805306688,
+    [162] = 1245188,
+    [163] = -2078674944,
+    [164] = 136803,
+    [165] = -200887,
+    [166] = 5995,
+    [167] = -2078674944,
+    [168] = 136803,
+    [169] = -200887,
+    [170] = 5995,
+    [171] = 3939,
+    [172] = 323401,
+    [173] = 5987,
+    [174] = 323401,
+    [175] = 1677723776,
+    [176] = 1208090624,
+    [177] = -200887,
+    [178] = 5995,
+    [179] = 10083,
+    [180] = 323401,
+    [181] = 805306688,
+    [182] = -2078674944,
+    [183] = 136803,
+    [184] = -200887,
+    [185] = 5995,
+    [186] = -2078674944,
+    [187] = 530019,
+    [188] = -200887,
+    [189] = 5995,
+    [190] = 3939,
+    [191] = 323401,
+    [192] = 5987,
+    [193] = 323401,
+    [194] = -1946023808,
+    [195] = 1310856,
+    [196] = -2078674944,
+    [197] = 530019,
+    [198] = -200887,
+    [199] = 5995,
+    [200] = -2078674944,
+    [201] = 530019,
+    [202] = -200887,
+    [203] = 5995,
+    [204] = 3939,
+    [205] = 323401,
+    [206] = 5987,
+    [207] = 323401,
+    [208] = 1811941504,
+    [209] = 1208090624,
+    [210] = -200887,
+    [211] = 5995,
+    [212] = 10083,
+    [213] = 323401,
+    [214] = 805306688,
+    [215] = 1900548,
+    [216] = 135177,
+    [217] = -200887,
+    [218] = 5995,
+    [219] = -2078674944,
+    [220] = 136803,
+    [221] = -200887,
+    [222] = 5995,
+    [223] = 3939,
+    [224] = 323401,
+    [225] = 5987,
+    [226] = 323401,
+    [227] = 1677723776,
+    [228] = 1208090624,
+    [229] = -200887,
+    [230] = 5995,
+    [231] = -2078674944,
+    [232] = 530019,
+    [233] = -200887,
+    [234] = 5995,
+    [235] = 3939,
+    [236] = 323401,
+    [237] = 5987,
+    [238] = 323401,
+    [239] = -2080241536,
+    [240] = -200887,
+    [241] = 5995,
+    [242] = 10083,
+    [243] = 323401,
+    [244] = 805306688,
+    [245] = 4105,
+    [246] = -200887,
+    [247] = 5995,
+    [248] = 5987,
+    [249] = 323401,
+    [250] = 69772,
+    [251] = 458884,
+    [252] = 4105,
+    [253] = -200887,
+    [254] = 5995,
+    [255] = 10083,
+    [256] = 323401,
+    [257] = 805306688,
+    [258] = 1179652,
+    [259] = -2078674944,
+    [260] = 530019,
+    [261] = -200887,
+    [262] = 5995,
+    [263] = -2078674944,
+    [264] = 136803,
+    [265] = -200887,
+    [266] = 5995,
+    [267] = 3939,
+    [268] = 323401,
+    [269] = 5987,
+    [270] = 323401,
+    [271] = -1946023808,
+    [272] = -200887,
+    [273] = 5995,
+    [274] = 10083,
+    [275] = 323401,
+    [276] = 805306688,
+    [277] = -2078674944,
+    [278] = 136803,
+    [279] = -200887,
+    [280] = 5995,
+    [281] = -2078674944,
+    [282] = 530019,
+    [283] = -200887,
+    [284] = 5995,
+    [285] = 3939,
+    [286] = 323401,
+    [287] = 5987,
+    [288] = 323401,
+    [289] = -1946023808,
+    [290] = 3473542,
+    [291] = 135177,
+    [292] = -200887,
+    [293] = 5995,
+    [294] = 5987,
+    [295] = 323401,
+    [296] = -2078674944,
+    [297] = 267883,
+    [298] = -2078674944,
+    [299] = 530019,
+    [300] = -200887,
+    [301] = 5995,
+    [302] = -2078674944,
+    [303] = 530019,
+    [304] = -200887,
+    [305] = 5995,
+    [306] = 3939,
+    [307] = 323401,
+    [308] = 5987,
+    [309] = 323401,
+    [310] = 1677723776,
+    [311] = 1208090624,
+    [312] = -200887,
+    [313] = 5995,
+    [314] = -2078674944,
+    [315] = 267875,
+    [316] = -200887,
+    [317] = 5995,
+    [318] = 3939,
+    [319] = 323401,
+    [320] = 5987,
+    [321] = 323401,
+    [322] = -2080241536,
+    [323] = -200887,
+    [324] = 5995,
+    [325] = 5987,
+    [326] = 323401,
+    [327] = -2078674944,
+    [328] = 333419,
+    [329] = -2078674944,
+    [330] = 333411,
+    [331] = -200887,
+    [332] = 5995,
+    [333] = 10083,
+    [334] = 323401,
+    [335] = 805306688,
+    [336] = -2078674944,
+    [337] = 267875,
+    [338] = -200887,
+    [339] = 5995,
+    [340] = 10083,
+    [341] = 323401,
+    [342] = 805306688,
+    [343] = 393220,
+    [344] = 69641,
+    [345] = -200887,
+    [346] = 5995,
+    [347] = 10083,
+    [348] = 323401,
+    [349] = 805306688,
+    [350] = -2078674944,
+    [351] = 136803,
+    [352] = -200887,
+    [353] = 5995,
+    [354] = -2078674944,
+    [355] = 530019,
+    [356] = -200887,
+    [357] = 5995,
+    [358] = 3939,
+    [359] = 323401,
+    [360] = 5987,
+    [361] = 323401,
+    [362] = -1946023808,
+    [363] = 3080327,
+    [364] = -2078674944,
+    [365] = 136803,
+    [366] = -200887,
+    [367] = 5995,
+    [368] = 5987,
+    [369] = 323401,
+    [370] = -2078674944,
+    [371] = 398955,
+    [372] = -2078674944,
+    [373] = 530019,
+    [374] = -200887,
+    [375] = 5995,
+    [376] = 5987,
+    [377] = 323401,
+    [378] = -2078674944,
+    [379] = 464491,
+    [380] = -2078674944,
+    [381] = 398947,
+    [382] = -200887,
+    [383] = 5995,
+    [384] = 5987,
+    [385] = 323401,
+    [386] = -2078674944,
+    [387] = 530027,
+    [388] = -2078674944,
+    [389] = 464483,
+    [390] = -200887,
+    [391] = 5995,
+    [392] = 5987,
+    [393] = 323401,
+    [394] = -2078674944,
+    [395] = 136811,
+    [396] = -2078674944,
+    [397] = 136803,
+    [398] = -200887,
+    [399] = 5995,
+    [400] = 10083,
+    [401] = 323401,
+    [402] = 805306688,
+    [403] = -2078674944,
+    [404] = 530019,
+    [405] = -200887,
+    [406] = 5995,
+    [407] = 10083,
+    [408] = 323401,
+    [409] = 805306688,
+    [410] = 1179652,
+    [411] = 4105,
+    [412] = -200887,
+    [413] = 5995,
+    [414] = -2078674944,
+    [415] = 136803,
+    [416] = -200887,
+    [417] = 5995,
+    [418] = 3939,
+    [419] = 323401,
+    [420] = 5987,
+    [421] = 323401,
+    [422] = 1811941504,
+    [423] = 1208090624,
+    [424] = -200887,
+    [425] = 5995,
+    [426] = 10083,
+    [427] = 323401,
+    [428] = 805306688,
+    [429] = -196701,
+    [430] = -292957,
+    [431] = -356445,
+    [432] = -419933,
+    [433] = -483421,
+    [434] = -546909,
+    [435] = -610397,
+    [436] = -673885,
+    [437] = -737373,
+    [438] = -4189,
+    [439] = -67677,
+    [440] = 61257,
+    [441] = 805307008,
+} };
+
+// Print msg and a newline on stderr, as the VM does, and exit with a failure code
+static void bail(const char *msg)
+{
+    fflush(stdout);
+    fprintf(stderr, "%s\n", msg);
+    exit(EXIT_FAILURE);
+}
+
+int main()
+{
+    int r0 = 0; // $0
+    int r1 = 0; // $at
+    int r2 = 0; // $v0
+    int r4 = 7636; // $a0
+    int r16 = 0; // $s0
+    int r17 = 0; // $s1
+    int r18 = 0; // $s2
+    int r19 = 0; // $s3
+    int r20 = 0; // $s4
+    int r21 = 0; // $s5
+    int r22 = 0; // $s6
+    int r23 = 0; // $s7
+    int r25 = 0; // $t9
+    int r29 = 7636; // $sp
+    int r30 = 7636; // $fp
+    int r31 = 0; // $ra
+    int lo = 0;
+    unsigned int pc;
+
+    pc = 0;
+    goto dispatch;
+ a0:	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r0;
+	// ADDI $0, $v0, 2
+	r2 = (int)((unsigned)r0 + (unsigned)2);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADDI $0, $v0, 0
+	r2 = (int)((unsigned)r0 + (unsigned)0);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// SW $sp, $sp, -1	# offset is -4 bytes
+	memory.words[(unsigned)((r29 + -4) / 4)] = r29;
+	// SW $sp, $fp, -2	# offset is -8 bytes
+	memory.words[(unsigned)((r29 + -8) / 4)] = r30;
+	// ADD $0, $sp, $fp
+	r30 = (int)((unsigned)r0 + (unsigned)r29);
+	// ADDI $sp, $sp, -48
+	r29 = (int)((unsigned)r29 + (unsigned)-48);
+	// SW $fp, $a0, -3	# offset is -12 bytes
+	memory.words[(unsigned)((r30 + -12) / 4)] = r4;
+	// SW $fp, $ra, -4	# offset is -16 bytes
+	memory.words[(unsigned)((r30 + -16) / 4)] = r31;
+	// SW $fp, $s0, -5	# offset is -20 bytes
+	memory.words[(unsigned)((r30 + -20) / 4)] = r16;
+	// SW $fp, $s1, -6	# offset is -24 bytes
+	memory.words[(unsigned)((r30 + -24) / 4)] = r17;
+	// SW $fp, $s2, -7	# offset is -28 bytes
+	memory.words[(unsigned)((r30 + -28) / 4)] = r18;
+	// SW $fp, $s3, -8	# offset is -32 bytes
+	memory.words[(unsigned)((r30 + -32) / 4)] = r19;
+	// SW $fp, $s4, -9	# offset is -36 bytes
+	memory.words[(unsigned)((r30 + -36) / 4)] = r20;
+	// SW $fp, $s5, -10	# offset is -40 bytes
+	memory.words[(unsigned)((r30 + -40) / 4)] = r21;
+	// SW $fp, $s6, -11	# offset is -44 bytes
+	memory.words[(unsigned)((r30 + -44) / 4)] = r22;
+	// SW $fp, $s7, -12	# offset is -48 bytes
+	memory.words[(unsigned)((r30 + -48) / 4)] = r23;
+	// ADDI $0, $v0, 3
+	r2 = (int)((unsigned)r0 + (unsigned)3);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 2	# offset is +8 bytes
+	memory.words[(unsigned)((r25 + 8) / 4)] = r2;
+	// ADDI $0, $v0, 4
+	r2 = (int)((unsigned)r0 + (unsigned)4);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 8	# offset is +32 bytes
+	memory.words[(unsigned)((r25 + 32) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 3	# offset is +12 bytes
+	r2 = memory.words[(unsigned)((r25 + 12) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 6	# offset is +24 bytes
+	r2 = memory.words[(unsigned)((r25 + 24) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $v0, $at, $v0
+	r2 = (int)((unsigned)r2 + (unsigned)r1);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 3	# offset is +12 bytes
+	memory.words[(unsigned)((r25 + 12) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 3	# offset is +12 bytes
+	r2 = memory.words[(unsigned)((r25 + 12) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 6	# offset is +24 bytes
+	r2 = memory.words[(unsigned)((r25 + 24) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// BNE $v0, $at, 8	# offset is +32 bytes
+	if (r2 != r1) goto a436;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// BEQ $0, $0, 6	# offset is +24 bytes
+	goto a460;
+ a436:	// ADDI $0, $v0, 0
+	r2 = (int)((unsigned)r0 + (unsigned)0);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+ a460:	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// BEQ $v0, $at, 8	# offset is +32 bytes
+	if (r2 == r1) goto a544;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// BEQ $0, $0, 6	# offset is +24 bytes
+	goto a568;
+ a544:	// ADDI $0, $v0, 2
+	r2 = (int)((unsigned)r0 + (unsigned)2);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+ a568:	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// SUB $v0, $at, $v0
+	r2 = (int)((unsigned)r2 - (unsigned)r1);
+	// BGEZ $v0, 7	# offset is +28 bytes
+	if (r2 >= 0) goto a652;
+	// ADDI $0, $v0, 108
+	r2 = (int)((unsigned)r0 + (unsigned)108);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// BEQ $0, $0, 19	# offset is +76 bytes
+	goto a728;
+ a652:	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// MUL $v0, $at
+	lo = (int)((unsigned)r2 * (unsigned)r1);
+	// MFLO $v0
+	r2 = lo;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+ a728:	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// SUB $v0, $at, $v0
+	r2 = (int)((unsigned)r2 - (unsigned)r1);
+	// BLTZ $v0, 20	# offset is +80 bytes
+	if (r2 < 0) goto a864;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// DIV $v0, $at
+	if (r1 == 0) { bail("Attempt to divide by zero!"); } lo = r2 / r1;
+	// MFLO $v0
+	r2 = lo;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// BEQ $0, $0, 29	# offset is +116 bytes
+	goto a980;
+ a864:	// ADDI $0, $v0, 2
+	r2 = (int)((unsigned)r0 + (unsigned)2);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// MUL $v0, $at
+	lo = (int)((unsigned)r2 * (unsigned)r1);
+	// MFLO $v0
+	r2 = lo;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $v0, $at, $v0
+	r2 = (int)((unsigned)r2 + (unsigned)r1);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+ a980:	// ADDI $0, $v0, 0
+	r2 = (int)((unsigned)r0 + (unsigned)0);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ANDI $v0, $v0, 0x1
+	r2 = r2 & 1;
+	// BEQ $v0, $0, 7	# offset is +28 bytes
+	if (r2 == r0) goto a1036;
+	// ADDI $0, $v0, 0
+	r2 = (int)((unsigned)r0 + (unsigned)0);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// BEQ $0, $0, 18	# offset is +72 bytes
+	goto a1108;
+ a1036:	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// SUB $v0, $at, $v0
+	r2 = (int)((unsigned)r2 - (unsigned)r1);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+ a1108:	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// SUB $v0, $at, $v0
+	r2 = (int)((unsigned)r2 - (unsigned)r1);
+	// BLEZ $v0, 53	# offset is +212 bytes
+	if (r2 <= 0) goto a1376;
+	// ADDI $0, $v0, 2
+	r2 = (int)((unsigned)r0 + (unsigned)2);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 4	# offset is +16 bytes
+	memory.words[(unsigned)((r25 + 16) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// MUL $v0, $at
+	lo = (int)((unsigned)r2 * (unsigned)r1);
+	// MFLO $v0
+	r2 = lo;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 4	# offset is +16 bytes
+	r2 = memory.words[(unsigned)((r25 + 16) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $v0, $at, $v0
+	r2 = (int)((unsigned)r2 + (unsigned)r1);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 5	# offset is +20 bytes
+	memory.words[(unsigned)((r25 + 20) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 5	# offset is +20 bytes
+	r2 = memory.words[(unsigned)((r25 + 20) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 4	# offset is +16 bytes
+	r2 = memory.words[(unsigned)((r25 + 16) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// BEQ $0, $0, 6	# offset is +24 bytes
+	goto a1400;
+ a1376:	// ADDI $0, $v0, 1
+	r2 = (int)((unsigned)r0 + (unsigned)1);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+ a1400:	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// SUB $v0, $at, $v0
+	r2 = (int)((unsigned)r2 - (unsigned)r1);
+	// BGTZ $v0, 47	# offset is +188 bytes
+	if (r2 > 0) goto a1644;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 6	# offset is +24 bytes
+	memory.words[(unsigned)((r25 + 24) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 7	# offset is +28 bytes
+	memory.words[(unsigned)((r25 + 28) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 6	# offset is +24 bytes
+	r2 = memory.words[(unsigned)((r25 + 24) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 8	# offset is +32 bytes
+	memory.words[(unsigned)((r25 + 32) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 7	# offset is +28 bytes
+	r2 = memory.words[(unsigned)((r25 + 28) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// SW $t9, $v0, 2	# offset is +8 bytes
+	memory.words[(unsigned)((r25 + 8) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 8	# offset is +32 bytes
+	r2 = memory.words[(unsigned)((r25 + 32) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+	// BEQ $0, $0, 18	# offset is +72 bytes
+	goto a1716;
+ a1644:	// ADDI $0, $v0, 0
+	r2 = (int)((unsigned)r0 + (unsigned)0);
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// ADD $0, $fp, $t9
+	r25 = (int)((unsigned)r0 + (unsigned)r30);
+	// LW $t9, $v0, 2	# offset is +8 bytes
+	r2 = memory.words[(unsigned)((r25 + 8) / 4)];
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $at, 0	# offset is +0 bytes
+	r1 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// DIV $v0, $at
+	if (r1 == 0) { bail("Attempt to divide by zero!"); } lo = r2 / r1;
+	// MFLO $v0
+	r2 = lo;
+	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $v0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r2;
+	// LW $sp, $a0, 0	# offset is +0 bytes
+	r4 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// PINT 
+	r2 = printf("%d", r4);
+ a1716:	// LW $fp, $ra, -4	# offset is -16 bytes
+	r31 = memory.words[(unsigned)((r30 + -16) / 4)];
+	// LW $fp, $s0, -5	# offset is -20 bytes
+	r16 = memory.words[(unsigned)((r30 + -20) / 4)];
+	// LW $fp, $s1, -6	# offset is -24 bytes
+	r17 = memory.words[(unsigned)((r30 + -24) / 4)];
+	// LW $fp, $s2, -7	# offset is -28 bytes
+	r18 = memory.words[(unsigned)((r30 + -28) / 4)];
+	// LW $fp, $s3, -8	# offset is -32 bytes
+	r19 = memory.words[(unsigned)((r30 + -32) / 4)];
+	// LW $fp, $s4, -9	# offset is -36 bytes
+	r20 = memory.words[(unsigned)((r30 + -36) / 4)];
+	// LW $fp, $s5, -10	# offset is -40 bytes
+	r21 = memory.words[(unsigned)((r30 + -40) / 4)];
+	// LW $fp, $s6, -11	# offset is -44 bytes
+	r22 = memory.words[(unsigned)((r30 + -44) / 4)];
+	// LW $fp, $s7, -12	# offset is -48 bytes
+	r23 = memory.words[(unsigned)((r30 + -48) / 4)];
+	// LW $fp, $sp, -1	# offset is -4 bytes
+	r29 = memory.words[(unsigned)((r30 + -4) / 4)];
+	// LW $fp, $fp, -2	# offset is -8 bytes
+	r30 = memory.words[(unsigned)((r30 + -8) / 4)];
+	// ADDI $sp, $sp, 0
+	r29 = (int)((unsigned)r29 + (unsigned)0);
+	// EXIT 
+	exit(0);
+	pc = 1768;
+ dispatch:
+    switch (pc) {
+    case 0: goto a0;
+    case 436: goto a436;
+    case 460: goto a460;
+    case 544: goto a544;
+    case 568: goto a568;
+    case 652: goto a652;
+    case 728: goto a728;
+    case 864: goto a864;
+    case 980: goto a980;
+    case 1036: goto a1036;
+    case 1108: goto a1108;
+    case 1376: goto a1376;
+    case 1400: goto a1400;
+    case 1644: goto a1644;
+    case 1716: goto a1716;
+    default:
+	fprintf(stderr, "bof2c: no code for address %u\n", pc);
+	bail("(only addresses of labels can be jumped to)");
+    }
+    return EXIT_SUCCESS;
+}
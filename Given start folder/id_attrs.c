@@ -7,7 +7,7 @@
 
 // Return a freshly allocated id_attrs struct
 // with its field file_loc set to floc, kind set to k, 
-// and its offset_count set to ofst_cnt.
+// its offset_count set to ofst_cnt, and its value 0.
 // If there is no space, bail with an error message,
 // so this should never return NULL.
 id_attrs *id_attrs_create(file_location floc, id_kind k,
@@ -20,6 +20,7 @@ id_attrs *id_attrs_create(file_location floc, id_kind k,
     ret->file_loc = floc;
     ret->kind = k;
     ret->offset_count = ofst_cnt;
+    ret->value = 0;
     return ret;
 }
 
@@ -35,6 +36,8 @@ extern id_attrs *id_attrs_proc_create(file_location floc)
     }
     ret->file_loc = floc;
     ret->kind = procedure_idk;
+    ret->offset_count = 0;
+    ret->value = 0;
     return ret;
 }
 
@@ -2,6 +2,7 @@
 #ifndef _ID_ATTRS_H
 #define _ID_ATTRS_H
 #include "file_location.h"
+#include "machine_types.h"
 
 // kinds of entries in the symbol table
 typedef enum {constant_idk, variable_idk, procedure_idk} id_kind;
@@ -14,11 +15,13 @@ typedef struct {
     // offset_count is the number of constant or variable decls before this one
     // in the current block
     unsigned int offset_count;
+    // for constants, the value the constant names (otherwise 0)
+    word_type value;
 } id_attrs;
 
 // Return a freshly allocated id_attrs struct
 // with its field file_loc set to floc, kind set to k, 
-// and its offset_count set to ofst_cnt.
+// its offset_count set to ofst_cnt, and its value 0.
 // If there is no space, bail with an error message,
 // so this should never return NULL.
 extern id_attrs *id_attrs_create(file_location floc, id_kind k,
@@ -63,8 +63,11 @@ void scope_check_constDefs(const_defs_t cdfs)
 // Put the given name, which is to be declared with kind k,
 // and has its declaration at the given file location (floc),
 // into the current scope's symbol table at the offset scope_size().
-static void add_ident_to_scope(const char *name, id_kind k, file_location floc)
+// Return the attributes it was given.
+static id_attrs *add_ident_to_scope(const char *name, id_kind k,
+				    file_location floc)
 {
+    id_attrs *attrs = NULL;
     id_use *idu = symtab_lookup(name);
     if (idu != NULL && idu->levelsOutward == 0) {
 	bail_with_prog_error(floc,
@@ -73,17 +76,21 @@ static void add_ident_to_scope(const char *name, id_kind k, file_location floc)
 			     name,
 			     id_attrs_id_kind_string(id_use_get_attrs(idu)->kind));
     } else {
-	symtab_insert(name,
-		      id_attrs_create(floc, k, symtab_scope_loc_count()));
+	attrs = id_attrs_create(floc, k, symtab_scope_loc_count());
+	symtab_insert(name, attrs);
     }
+    return attrs;
 }
 
 // build the symbol table and check the const definition cdf
 // and add the declared name to the current scope's symbol table
 // or produce an error if this name has already been declared
+// (recording the constant's value in its attributes)
 void scope_check_constDef(const_def_t cdf)
 {
-    add_ident_to_scope(cdf.ident.name, constant_idk, *(cdf.file_loc));
+    id_attrs *attrs = add_ident_to_scope(cdf.ident.name, constant_idk,
+					 *(cdf.file_loc));
+    attrs->value = cdf.number.value;
 }
 
 // build the symbol table and check the declarations in vds
@@ -27,6 +27,7 @@ extern void scope_check_constDefs(const_defs_t cdfs);
 // build the symbol table and check the const definition cdf
 // and add the declared name to the current scope's symbol table
 // or produce an error if its name has already been declared
+// (recording the constant's value in its attributes)
 extern void scope_check_constDef(const_def_t cdf);
 
 // build the symbol table and check the declarations in vds
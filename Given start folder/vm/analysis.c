@@ -0,0 +1,302 @@
+/* $Id$ */
+#include <stdlib.h>
+#include "analysis.h"
+#include "utilities.h"
+
+// a line of the simulated cache
+typedef struct {
+    bool valid;
+    // has the line been stored into since it was read in?
+    bool dirty;
+    // the line's address (its byte address / the line size)
+    address_type line_address;
+    // the value of the cache's clock when the line was last used
+    unsigned long last_used;
+} cache_line_t;
+
+// the models and the counts gathered by feeding them a program
+struct analysis_s {
+    cache_config_t cache_config;
+    predictor_config_t predictor_config;
+    // the number of sets in the cache
+    unsigned int sets;
+    // the cache's lines, with set s in lines[s*ways] to lines[(s+1)*ways-1]
+    cache_line_t *lines;
+    // the number of accesses to the cache so far (for LRU replacement)
+    unsigned long clock;
+    // the number of lines read into the cache and written back from it
+    unsigned long lines_read;
+    unsigned long lines_written_back;
+    // the number of loads and of stores
+    unsigned long loads;
+    unsigned long stores;
+    // the predictor's table of 2-bit counters (0 and 1 predict not taken,
+    // 2 and 3 taken), and (for gshare) the global history of outcomes
+    unsigned char *counters;
+    unsigned int history;
+    // the number of words of the program's text
+    unsigned int program_words;
+    // the number of memory accesses (and misses)
+    // by the instruction at each word address
+    unsigned long *accesses;
+    unsigned long *misses;
+    // the number of executions (and mispredictions)
+    // of the conditional branch at each word address
+    unsigned long *branches;
+    unsigned long *mispredictions;
+};
+
+// Return true if n is a power of 2
+static bool is_power_of_2(unsigned int n)
+{
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+// Return true if c describes a cache that can be simulated:
+// its sizes are powers of 2, and it has room for at least one set,
+// of lines that are at least a word long
+bool analysis_cache_config_okay(cache_config_t c)
+{
+    return is_power_of_2(c.size) && is_power_of_2(c.line_size)
+	&& is_power_of_2(c.ways) && c.line_size >= BYTES_PER_WORD
+	&& c.size / c.line_size >= c.ways;
+}
+
+// Return true if c describes a predictor that can be simulated
+// (its index_bits is at most MAX_PREDICTOR_INDEX_BITS)
+bool analysis_predictor_config_okay(predictor_config_t c)
+{
+    return c.index_bits <= MAX_PREDICTOR_INDEX_BITS;
+}
+
+// Return a new array of count counts, all 0
+// (with one more than needed, so an empty program allocates some)
+static unsigned long *make_counts(unsigned int count)
+{
+    unsigned long *counts
+	= (unsigned long *)calloc(count + 1, sizeof(unsigned long));
+    if (counts == NULL) {
+	bail_with_error("Cannot allocate space for an analysis!");
+    }
+    return counts;
+}
+
+// Requires: analysis_cache_config_okay(cache)
+//        && analysis_predictor_config_okay(predictor)
+// Return a new analysis, with an empty cache, a predictor that
+// predicts not taken everywhere, and all counts 0,
+// of a program with count words of text
+analysis_t *analysis_create(cache_config_t cache,
+			    predictor_config_t predictor,
+			    unsigned int count)
+{
+    analysis_t *a = (analysis_t *)calloc(1, sizeof(analysis_t));
+    if (a == NULL) {
+	bail_with_error("Cannot allocate space for an analysis!");
+    }
+    a->cache_config = cache;
+    a->predictor_config = predictor;
+    a->sets = cache.size / (cache.line_size * cache.ways);
+    a->lines = (cache_line_t *)
+	calloc(a->sets * cache.ways, sizeof(cache_line_t));
+    // (all counters start weakly not taken)
+    a->counters = (unsigned char *)malloc(1u << predictor.index_bits);
+    if (a->lines == NULL || a->counters == NULL) {
+	bail_with_error("Cannot allocate space for an analysis!");
+    }
+    for (unsigned int i = 0; i < (1u << predictor.index_bits); i++) {
+	a->counters[i] = 1;
+    }
+    a->program_words = count;
+    a->accesses = make_counts(count);
+    a->misses = make_counts(count);
+    a->branches = make_counts(count);
+    a->mispredictions = make_counts(count);
+    return a;
+}
+
+// Free the analysis a
+void analysis_destroy(analysis_t *a)
+{
+    free(a->lines);
+    free(a->counters);
+    free(a->accesses);
+    free(a->misses);
+    free(a->branches);
+    free(a->mispredictions);
+    free(a);
+}
+
+// Requires: wa is less than a's program's number of words of text
+// Feed a's cache the load (or store, if is_store) at byte address ba
+// by the instruction at word address wa
+void analysis_memory_access(analysis_t *a, address_type wa,
+			    address_type ba, bool is_store)
+{
+    address_type line_address = ba / a->cache_config.line_size;
+    cache_line_t *set
+	= &a->lines[(line_address & (a->sets - 1)) * a->cache_config.ways];
+    a->clock++;
+    a->accesses[wa]++;
+    if (is_store) {
+	a->stores++;
+    } else {
+	a->loads++;
+    }
+    // the line to replace on a miss: an invalid one if there is one,
+    // otherwise the least recently used
+    cache_line_t *victim = &set[0];
+    for (unsigned int w = 0; w < a->cache_config.ways; w++) {
+	if (set[w].valid && set[w].line_address == line_address) {
+	    set[w].last_used = a->clock;
+	    set[w].dirty = set[w].dirty || is_store;
+	    return;
+	}
+	if (victim->valid
+	    && (!set[w].valid || set[w].last_used < victim->last_used)) {
+	    victim = &set[w];
+	}
+    }
+    a->misses[wa]++;
+    if (victim->valid && victim->dirty) {
+	a->lines_written_back++;
+    }
+    a->lines_read++;
+    victim->valid = true;
+    victim->dirty = is_store;
+    victim->line_address = line_address;
+    victim->last_used = a->clock;
+}
+
+// Requires: wa is less than a's program's number of words of text
+// Feed a's predictor the conditional branch at word address wa,
+// which was taken if taken is true
+void analysis_branch(analysis_t *a, address_type wa, bool taken)
+{
+    unsigned int mask = (1u << a->predictor_config.index_bits) - 1;
+    unsigned int index = wa;
+    if (a->predictor_config.kind == gshare_predictor) {
+	index ^= a->history;
+	a->history = ((a->history << 1) | taken) & mask;
+    }
+    unsigned char *counter = &a->counters[index & mask];
+    a->branches[wa]++;
+    if ((*counter >= 2) != taken) {
+	a->mispredictions[wa]++;
+    }
+    if (taken && *counter < 3) {
+	(*counter)++;
+    } else if (!taken && *counter > 0) {
+	(*counter)--;
+    }
+}
+
+// an instruction with a count of misses, for sorting by that count
+typedef struct {
+    unsigned int index;
+    unsigned long count;
+} counted_t;
+
+// Return a negative number, 0, or a positive number as the counted_t
+// pointed to by p should come before, is the same as, or should come after
+// the one pointed to by q: those with larger counts come first,
+// and those with equal counts are in order of their indexes
+static int compare_counted(const void *p, const void *q)
+{
+    const counted_t *a = (const counted_t *)p;
+    const counted_t *b = (const counted_t *)q;
+    if (a->count != b->count) {
+	return (a->count > b->count) ? -1 : 1;
+    }
+    return (a->index > b->index) - (a->index < b->index);
+}
+
+// Return the percentage that count is of total
+static double percent(unsigned long count, unsigned long total)
+{
+    return (total == 0) ? 0.0 : (100.0 * count) / total;
+}
+
+// Requires: instrs has a->program_words elements,
+//           and sorted has room for that many elements
+// Print a table to out of the instructions of instrs with non-zero
+// events, with their events and misses, from the one with the most
+// misses to the least, using sorted to sort them
+static void print_misses(analysis_t *a, const bin_instr_t *instrs,
+			 const unsigned long *events,
+			 const unsigned long *misses,
+			 const char *events_name, const char *misses_name,
+			 counted_t *sorted, FILE *out)
+{
+    unsigned int num = 0;
+    for (unsigned int wa = 0; wa < a->program_words; wa++) {
+	if (events[wa] > 0) {
+	    sorted[num].index = wa;
+	    sorted[num].count = misses[wa];
+	    num++;
+	}
+    }
+    qsort(sorted, num, sizeof(counted_t), compare_counted);
+    fprintf(out, "%8s %12s %12s %7s  %s\n",
+	    "addr", events_name, misses_name, "%", "instruction");
+    for (unsigned int i = 0; i < num; i++) {
+	unsigned int wa = sorted[i].index;
+	fprintf(out, "%8u %12lu %12lu %7.2f  %s\n", wa * BYTES_PER_WORD,
+		events[wa], misses[wa], percent(misses[wa], events[wa]),
+		instruction_assembly_form(instrs[wa]));
+    }
+}
+
+// Return the sum of the count counts in counts
+static unsigned long sum(const unsigned long *counts, unsigned int count)
+{
+    unsigned long total = 0;
+    for (unsigned int i = 0; i < count; i++) {
+	total += counts[i];
+    }
+    return total;
+}
+
+// Requires: instrs has as many elements as a's program has words of text
+// Print a report of a to out, for the program whose text is instrs:
+// the cache's and the predictor's shapes and overall miss rates,
+// then the instructions that accessed memory, from the one that missed
+// most to the least, and the conditional branches, from the one
+// mispredicted most to the least, each with its miss rate
+void analysis_print_report(analysis_t *a, const bin_instr_t *instrs,
+			   FILE *out)
+{
+    counted_t *sorted = (counted_t *)
+	malloc((a->program_words + 1) * sizeof(counted_t));
+    if (sorted == NULL) {
+	bail_with_error("Cannot allocate space to sort an analysis!");
+    }
+
+    cache_config_t c = a->cache_config;
+    unsigned long accesses = a->loads + a->stores;
+    unsigned long misses = sum(a->misses, a->program_words);
+    fprintf(out, "Cache: %u bytes, %u-byte lines, %u-way set associative"
+	    " (%u sets), LRU, write-back:\n",
+	    c.size, c.line_size, c.ways, a->sets);
+    fprintf(out, "%lu accesses (%lu loads, %lu stores), %lu misses (%.2f%%)\n",
+	    accesses, a->loads, a->stores, misses, percent(misses, accesses));
+    fprintf(out, "memory traffic: %lu bytes (%lu lines read,"
+	    " %lu lines written back)\n",
+	    (a->lines_read + a->lines_written_back) * c.line_size,
+	    a->lines_read, a->lines_written_back);
+    print_misses(a, instrs, a->accesses, a->misses, "accesses", "misses",
+		 sorted, out);
+
+    predictor_config_t p = a->predictor_config;
+    unsigned long branches = sum(a->branches, a->program_words);
+    unsigned long mispredictions = sum(a->mispredictions, a->program_words);
+    fprintf(out, "Branch predictor: %s, %u 2-bit counters%s:\n",
+	    (p.kind == gshare_predictor) ? "gshare" : "2bit",
+	    1u << p.index_bits,
+	    (p.kind == gshare_predictor) ? " (indexed with the history)" : "");
+    fprintf(out, "%lu branches, %lu mispredicted (%.2f%%)\n",
+	    branches, mispredictions, percent(mispredictions, branches));
+    print_misses(a, instrs, a->branches, a->mispredictions,
+		 "branches", "mispredicted", sorted, out);
+    free(sorted);
+}
@@ -0,0 +1,96 @@
+/* $Id$ */
+// Simulated models of a data cache and a branch predictor,
+// fed the memory accesses and conditional branches of a program
+// as the VM runs it (with -A), to judge code by its memory traffic
+// and how predictable its branches are, not just by how many
+// instructions it executes
+#ifndef _ANALYSIS_H
+#define _ANALYSIS_H
+#include <stdio.h>
+#include <stdbool.h>
+#include "machine_types.h"
+#include "instruction.h"
+
+// the shape of a simulated data cache, which is set associative,
+// with least-recently-used replacement, and write-back
+// with write allocate (so a store that misses reads the line in)
+typedef struct {
+    // the cache's size in bytes
+    unsigned int size;
+    // the size of each line in bytes
+    unsigned int line_size;
+    // the number of lines in each set
+    unsigned int ways;
+} cache_config_t;
+
+// the default cache: 4096 bytes of 16-byte lines, 2-way set associative
+#define DEFAULT_CACHE_CONFIG ((cache_config_t){4096, 16, 2})
+
+// the kinds of simulated branch predictors
+typedef enum {
+    // a table of 2-bit saturating counters indexed by the branch's address
+    two_bit_predictor,
+    // the same, indexed by the branch's address xor'd with the global
+    // history of the outcomes of the latest branches
+    gshare_predictor
+} predictor_kind;
+
+// the shape of a simulated branch predictor
+typedef struct {
+    predictor_kind kind;
+    // the log (base 2) of the number of counters in the table
+    // (for gshare, also the number of branches in the history)
+    unsigned int index_bits;
+} predictor_config_t;
+
+// the default predictor: 1024 2-bit counters
+#define DEFAULT_PREDICTOR_CONFIG ((predictor_config_t){two_bit_predictor, 10})
+
+// the largest index_bits a predictor may have
+#define MAX_PREDICTOR_INDEX_BITS 24
+
+// the models and the counts gathered by feeding them a program
+typedef struct analysis_s analysis_t;
+
+// Return true if c describes a cache that can be simulated:
+// its sizes are powers of 2, and it has room for at least one set,
+// of lines that are at least a word long
+extern bool analysis_cache_config_okay(cache_config_t c);
+
+// Return true if c describes a predictor that can be simulated
+// (its index_bits is at most MAX_PREDICTOR_INDEX_BITS)
+extern bool analysis_predictor_config_okay(predictor_config_t c);
+
+// Requires: analysis_cache_config_okay(cache)
+//        && analysis_predictor_config_okay(predictor)
+// Return a new analysis, with an empty cache, a predictor that
+// predicts not taken everywhere, and all counts 0,
+// of a program with count words of text
+extern analysis_t *analysis_create(cache_config_t cache,
+				   predictor_config_t predictor,
+				   unsigned int count);
+
+// Free the analysis a
+extern void analysis_destroy(analysis_t *a);
+
+// Requires: wa is less than a's program's number of words of text
+// Feed a's cache the load (or store, if is_store) at byte address ba
+// by the instruction at word address wa
+extern void analysis_memory_access(analysis_t *a, address_type wa,
+				   address_type ba, bool is_store);
+
+// Requires: wa is less than a's program's number of words of text
+// Feed a's predictor the conditional branch at word address wa,
+// which was taken if taken is true
+extern void analysis_branch(analysis_t *a, address_type wa, bool taken);
+
+// Requires: instrs has as many elements as a's program has words of text
+// Print a report of a to out, for the program whose text is instrs:
+// the cache's and the predictor's shapes and overall miss rates,
+// then the instructions that accessed memory, from the one that missed
+// most to the least, and the conditional branches, from the one
+// mispredicted most to the least, each with its miss rate
+extern void analysis_print_report(analysis_t *a, const bin_instr_t *instrs,
+				  FILE *out);
+
+#endif
@@ -0,0 +1,30 @@
+	# $Id$
+	# fills an array, then sums it twice, for testing the VM's
+	# simulated cache and branch predictor (-A), which is run
+	# with a cache smaller than the array, so each pass misses
+	.text start
+start:	ADDI $0, $t0, 0      # $t0 is the byte offset into the array
+	ADDI $0, $t2, 128    # the array is 128 bytes long
+fill:	ADD $gp, $t0, $t3    # $t3 is the address of the element
+	SW $t3, $t0, 0       # the element is its offset
+	ADDI $t0, $t0, 4
+	BNE $t0, $t2, -4     # back to fill until the end of the array
+	ADDI $0, $t1, 2      # $t1 counts the passes that sum the array
+pass:	ADDI $0, $t0, 0
+	ADDI $0, $s0, 0      # $s0 is the sum
+sum:	ADD $gp, $t0, $t3
+	LW $t3, $t4, 0
+	ADD $s0, $t4, $s0
+	ADDI $t0, $t0, 4
+	BNE $t0, $t2, -5     # back to sum until the end of the array
+	ADDI $t1, $t1, -1
+	BGTZ $t1, -9         # back to pass while $t1 > 0
+	ADD $0, $s0, $a0     # print the sum and a newline
+	PINT
+	ADDI $0, $a0, 10
+	PCH
+	EXIT
+	.data 1024
+	WORD array = 0
+	.stack 4096
+	.end
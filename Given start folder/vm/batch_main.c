@@ -0,0 +1,325 @@
+/* $Id$ */
+// vm-batch: run many .bof files in the VM at once, on a pool of threads.
+// Each program runs in its own machine (see machine.h), with its own
+// memory and captured output, and a report gives each program's
+// exit status, instruction count, and running time.
+// A file that cannot be loaded (e.g., one that is not a valid BOF file)
+// fails with exit status EXIT_FAILURE, and its error message
+// as its output, without stopping the rest of the batch.
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "bof.h"
+#include "machine.h"
+#include "utilities.h"
+
+// the result of running one program
+typedef struct {
+    const char *file_name;
+    int status;
+    unsigned long instructions;
+    double secs;
+    // the number of bytes of output (and error messages) it wrote
+    size_t output_bytes;
+} result_t;
+
+// the programs to run, with their results, and how many there are
+static result_t *results;
+static unsigned int num_programs;
+
+// the index in results of the next program to run,
+// which is protected by next_lock
+static unsigned int next_program = 0;
+static pthread_mutex_t next_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// how the machines run the programs (from the command line)
+static check_mode_type check_mode = paranoid_checking;
+static bool use_blocks = false;
+static bool use_jit = false;
+static unsigned long max_instrs = 0;
+static unsigned long max_ms = 0;
+
+// the file each program reads its input from,
+// and the directory for the programs' outputs (or NULL)
+static const char *input_name = "/dev/null";
+static const char *output_dir = NULL;
+
+/* Print a usage message on stderr and exit with exit code 1. */
+static void usage(const char *cmdname)
+{
+    fprintf(stderr, "Usage: %s [-n threads] [-b | -j] [-O | --paranoid] [--max-instrs N] [--max-ms T] [-i input] [-o dir] (file.bof ... | dir)\n", cmdname);
+    fprintf(stderr, "(a file.snap, written by the VM's --snapshot-at, may be given\n");
+    fprintf(stderr, " instead of a file.bof, to run that program from its snapshot;\n");
+    fprintf(stderr, " -n runs the programs on that many threads (default: one per core),\n");
+    fprintf(stderr, " -b, -j, -O, --paranoid, --max-instrs, and --max-ms are as for the VM\n");
+    fprintf(stderr, "    (the limits apply to each program),\n");
+    fprintf(stderr, " -i makes each program read the file input (default: /dev/null),\n");
+    fprintf(stderr, " -o writes each program's output and error messages to dir/name.myo,\n");
+    bail_with_error(" and a directory argument runs all of its .bof files)");
+}
+
+// Return the number of seconds from start to end
+static double seconds_between(struct timespec start, struct timespec end)
+{
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+// Write the size bytes of output from the program file_name
+// into the file output_dir/name.myo, where name.bof
+// (or name.snap) is its base name
+static void save_output(const char *file_name, const char *output, size_t size)
+{
+    const char *base = strrchr(file_name, '/');
+    base = (base == NULL) ? file_name : base + 1;
+    size_t len = strlen(base);
+    if (len > 4 && strcmp(base + len - 4, ".bof") == 0) {
+	len -= 4;
+    } else if (len > 5 && strcmp(base + len - 5, ".snap") == 0) {
+	len -= 5;
+    }
+    char path[strlen(output_dir) + len + 6];
+    sprintf(path, "%s/%.*s.myo", output_dir, (int)len, base);
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+	bail_with_error("Cannot open %s for writing!", path);
+    }
+    fwrite(output, 1, size, f);
+    fclose(f);
+}
+
+// Load the program named file_name into m (from its snapshot,
+// if it is a .snap file), and return true if that worked
+// (otherwise an error message has been written on err)
+static bool load_program(machine_t *m, const char *file_name, FILE *err)
+{
+    size_t len = strlen(file_name);
+    if (len > 5 && strcmp(file_name + len - 5, ".snap") == 0) {
+	return machine_try_restore(m, file_name);
+    }
+    // (opened here, as bof_read_open exits if it cannot open the file)
+    BOFFILE bf = {fopen(file_name, "rb"), file_name};
+    if (bf.fileptr == NULL) {
+	fprintf(err, "Cannot open %s for reading: %s\n",
+		file_name, strerror(errno));
+	return false;
+    }
+    bool okay = machine_try_load(m, bf);
+    fclose(bf.fileptr);
+    return okay;
+}
+
+// Load the program results[i].file_name into m (from its snapshot,
+// if it is a .snap file), run it to completion,
+// capturing its output, and record the results in results[i]
+// (a program that cannot be loaded does not run,
+// and its exit status is EXIT_FAILURE)
+static void run_program(machine_t *m, unsigned int i)
+{
+    result_t *r = &results[i];
+    char *output = NULL;
+    size_t output_size = 0;
+    FILE *out = open_memstream(&output, &output_size);
+    FILE *in = fopen(input_name, "r");
+    if (out == NULL || in == NULL) {
+	bail_with_error("Cannot open the files to run %s with!", r->file_name);
+    }
+    machine_set_files(m, in, out, out);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    errno = 0; // so error messages are as from a new VM process
+    if (load_program(m, r->file_name, out)) {
+	errno = 0;
+	r->status = machine_run(m, false);
+	r->instructions = machine_instruction_count(m);
+    } else {
+	r->status = EXIT_FAILURE;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    r->secs = seconds_between(start, end);
+    fclose(in);
+    fclose(out);
+    r->output_bytes = output_size;
+    if (output_dir != NULL) {
+	save_output(r->file_name, output, output_size);
+    }
+    free(output);
+}
+
+// Run programs, in a machine of this thread's own,
+// until there are none left to run
+static void *worker(void *arg)
+{
+    machine_t *m = machine_create();
+    machine_set_check_mode(m, check_mode);
+    machine_set_block_mode(m, use_blocks);
+    machine_set_jit_mode(m, use_jit);
+    machine_set_limits(m, max_instrs, max_ms);
+    while (true) {
+	pthread_mutex_lock(&next_lock);
+	unsigned int i = next_program++;
+	pthread_mutex_unlock(&next_lock);
+	if (i >= num_programs) {
+	    break;
+	}
+	run_program(m, i);
+    }
+    machine_destroy(m);
+    return NULL;
+}
+
+// Return a negative number, 0, or a positive number as the string
+// pointed to by p comes before, is equal to, or comes after
+// the one pointed to by q (for qsort)
+static int compare_names(const void *p, const void *q)
+{
+    return strcmp(*(const char * const *)p, *(const char * const *)q);
+}
+
+// Return the names of the .bof files in the directory dir_name,
+// in sorted order, setting *count to the number of them
+static char **bof_files_in(const char *dir_name, unsigned int *count)
+{
+    DIR *dir = opendir(dir_name);
+    if (dir == NULL) {
+	bail_with_error("Cannot open the directory %s!", dir_name);
+    }
+    char **names = NULL;
+    unsigned int n = 0;
+    struct dirent *e;
+    while ((e = readdir(dir)) != NULL) {
+	size_t len = strlen(e->d_name);
+	if (len <= 4 || strcmp(e->d_name + len - 4, ".bof") != 0) {
+	    continue;
+	}
+	names = (char **)realloc(names, (n + 1) * sizeof(char *));
+	char *path = (char *)malloc(strlen(dir_name) + len + 2);
+	if (names == NULL || path == NULL) {
+	    bail_with_error("Cannot allocate space for the names of files!");
+	}
+	sprintf(path, "%s/%s", dir_name, e->d_name);
+	names[n++] = path;
+    }
+    closedir(dir);
+    qsort(names, n, sizeof(char *), compare_names);
+    *count = n;
+    return names;
+}
+
+// Run the VM on the .bof files named in argv (or in a directory)
+int main(int argc, char *argv[])
+{
+    const char *cmdname = argv[0];
+    argc--;
+    argv++;
+
+    long num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    while (argc > 0 && argv[0][0] == '-') {
+	if (strcmp(argv[0], "-n") == 0 && argc > 1) {
+	    num_threads = parse_count(argv[0], argv[1]);
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "--max-instrs") == 0 && argc > 1) {
+	    max_instrs = parse_count(argv[0], argv[1]);
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "--max-ms") == 0 && argc > 1) {
+	    max_ms = parse_count(argv[0], argv[1]);
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "-i") == 0 && argc > 1) {
+	    input_name = argv[1];
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "-o") == 0 && argc > 1) {
+	    output_dir = argv[1];
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "-b") == 0) {
+	    use_blocks = true;
+	} else if (strcmp(argv[0], "-j") == 0) {
+	    use_jit = true;
+	    check_mode = release_checking;
+	} else if (strcmp(argv[0], "-O") == 0) {
+	    check_mode = release_checking;
+	} else if (strcmp(argv[0], "--paranoid") == 0) {
+	    check_mode = paranoid_checking;
+	} else {
+	    usage(cmdname);
+	}
+	argc--;
+	argv++;
+    }
+    if (argc < 1 || num_threads < 1) {
+	usage(cmdname);
+    }
+
+    // the programs to run
+    char **names = argv;
+    unsigned int count = argc;
+    struct stat st;
+    if (argc == 1 && stat(argv[0], &st) == 0 && S_ISDIR(st.st_mode)) {
+	names = bof_files_in(argv[0], &count);
+    }
+    for (unsigned int i = 0; i < count; i++) {
+	// (check now, as the VM exits if it cannot open a file)
+	if (stat(names[i], &st) != 0 || !S_ISREG(st.st_mode)) {
+	    bail_with_error("Cannot run %s, which is not a file!", names[i]);
+	}
+    }
+    num_programs = count;
+    results = (result_t *)calloc(count + 1, sizeof(result_t));
+    if (results == NULL) {
+	bail_with_error("Cannot allocate space for the results!");
+    }
+    for (unsigned int i = 0; i < count; i++) {
+	results[i].file_name = names[i];
+    }
+    if (num_threads > count) {
+	num_threads = (count > 0) ? count : 1;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_t threads[num_threads];
+    for (long t = 0; t < num_threads; t++) {
+	int err = pthread_create(&threads[t], NULL, worker, NULL);
+	if (err != 0) {
+	    errno = err;
+	    bail_with_error("Cannot create a thread");
+	}
+    }
+    for (long t = 0; t < num_threads; t++) {
+	pthread_join(threads[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    // the report, in the order the programs were given
+    unsigned int failures = 0;
+    unsigned long total_instructions = 0;
+    printf("%-28s %6s %14s %10s %8s\n",
+	   "program", "status", "instructions", "seconds", "output");
+    for (unsigned int i = 0; i < count; i++) {
+	const result_t *r = &results[i];
+	printf("%-28s %6d %14lu %10.6f %8zu\n", r->file_name, r->status,
+	       r->instructions, r->secs, r->output_bytes);
+	if (r->status != EXIT_SUCCESS) {
+	    failures++;
+	}
+	total_instructions += r->instructions;
+    }
+    printf("%u programs (%u with a nonzero exit status), "
+	   "%lu instructions in %.6f seconds on %ld thread%s\n",
+	   count, failures, total_instructions,
+	   seconds_between(start, end), num_threads,
+	   (num_threads == 1) ? "" : "s");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/* Generated by bof2c from bench_loop.bof; do not edit */
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MEMORY_SIZE_IN_BYTES 65532
+#define MEMORY_SIZE_IN_WORDS 16383
+
+// the SRM's memory, holding the program's text and data
+static union {
+    unsigned char bytes[MEMORY_SIZE_IN_BYTES];
+    int words[MEMORY_SIZE_IN_WORDS];
+} memory = { .words = {
+    [0] = 18211,
+    [1] = 18441,
+    [2] = -200887,
+    [3] = 18283,
+    [4] = 5987,
+    [5] = 323401,
+    [6] = -1744235968,
+    [7] = -48631,
+    [8] = -458233,
+    [9] = -2080094208,
+    [10] = 805306688,
+    [11] = 663561,
+    [12] = 805307072,
+    [13] = 805307008,
+    [256] = 10000000,
+} };
+
+// Print msg and a newline on stderr, as the VM does, and exit with a failure code
+static void bail(const char *msg)
+{
+    fflush(stdout);
+    fprintf(stderr, "%s\n", msg);
+    exit(EXIT_FAILURE);
+}
+
+int main()
+{
+    int r0 = 0; // $0
+    int r2 = 0; // $v0
+    int r4 = 4096; // $a0
+    int r8 = 0; // $t0
+    int r9 = 0; // $t1
+    int r28 = 1024; // $gp
+    int r29 = 4096; // $sp
+    unsigned int pc;
+
+    pc = 0;
+    goto dispatch;
+ a0:	// LW $gp, $t0, 0	# offset is +0 bytes
+	r8 = memory.words[(unsigned)((r28 + 0) / 4)];
+	// ADDI $0, $t1, 0
+	r9 = (int)((unsigned)r0 + (unsigned)0);
+ a8:	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $t0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r8;
+	// LW $sp, $v0, 0	# offset is +0 bytes
+	r2 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// XOR $t1, $v0, $t1
+	r9 = r9 ^ r2;
+	// ADDI $t0, $t0, -1
+	r8 = (int)((unsigned)r8 + (unsigned)-1);
+	// BGTZ $t0, -7	# offset is -28 bytes
+	if (r8 > 0) goto a8;
+	// ADD $0, $t1, $a0
+	r4 = (int)((unsigned)r0 + (unsigned)r9);
+	// PINT 
+	r2 = printf("%d", r4);
+	// ADDI $0, $a0, 10
+	r4 = (int)((unsigned)r0 + (unsigned)10);
+	// PCH 
+	r2 = fputc(r4, stdout);
+	// EXIT 
+	exit(0);
+	pc = 56;
+ dispatch:
+    switch (pc) {
+    case 0: goto a0;
+    case 8: goto a8;
+    default:
+	fprintf(stderr, "bof2c: no code for address %u\n", pc);
+	bail("(only addresses of labels can be jumped to)");
+    }
+    return EXIT_SUCCESS;
+}
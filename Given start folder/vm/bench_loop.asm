@@ -0,0 +1,22 @@
+	# $Id$
+	# benchmark: a counting loop in the style of compiled PL/0 code,
+	# which pushes and pops through the runtime stack on each iteration
+	.text start
+start:	LW $gp, $t0, 0       # $t0 is the loop count
+	ADDI $0, $t1, 0      # $t1 accumulates the values
+loop:	ADDI $sp, $sp, -4    # push $t0
+	SW $sp, $t0, 0
+	LW $sp, $v0, 0       # pop it into $v0
+	ADDI $sp, $sp, 4
+	XOR $t1, $v0, $t1    # $t1 ^= $v0
+	ADDI $t0, $t0, -1    # $t0--
+	BGTZ $t0, -7         # back to loop while $t0 > 0
+	ADD $0, $t1, $a0     # print the result
+	PINT
+	ADDI $0, $a0, 10     # and a newline
+	PCH
+	EXIT
+	.data 1024
+	WORD count = 10000000
+	.stack 4096
+	.end
@@ -0,0 +1,166 @@
+/* $Id$ */
+#include <stdlib.h>
+#include "blocks.h"
+#include "machine.h"
+#include "utilities.h"
+
+struct block_cache_s {
+    // the pre-decoded program, its leaders, and its length in words
+    const decoded_instr_t *program;
+    const bool *is_leader;
+    unsigned int program_words;
+    // the block starting at each word address of the program, if made
+    block_t **block_at;
+    // the most recently made block (the start of a list of all of them)
+    block_t *last_made;
+};
+
+// Requires: dis and leaders have count elements
+//           (leaders as set by decode_find_leaders),
+//           and they stay allocated while the blocks are used
+// Return a new, empty cache of the basic blocks of the pre-decoded
+// program dis, whose blocks start at the leaders
+block_cache_t *blocks_create(const decoded_instr_t *dis, const bool *leaders,
+			     unsigned int count)
+{
+    block_cache_t *c = (block_cache_t *)malloc(sizeof(block_cache_t));
+    // (one more entry than needed, so an empty program allocates some)
+    block_t **at = (block_t **)calloc(count + 1, sizeof(block_t *));
+    if (c == NULL || at == NULL) {
+	bail_with_error("Cannot allocate a cache of basic blocks!");
+    }
+    c->program = dis;
+    c->is_leader = leaders;
+    c->program_words = count;
+    c->block_at = at;
+    c->last_made = NULL;
+    return c;
+}
+
+// Free the cache c and all of its blocks
+void blocks_destroy(block_cache_t *c)
+{
+    while (c->last_made != NULL) {
+	block_t *b = c->last_made;
+	c->last_made = b->made_before;
+	free(b);
+    }
+    free(c->block_at);
+    free(c);
+}
+
+// Requires: wa < c->program_words
+// Return a new block in c starting at word address wa,
+// which extends to the first instruction that ends a block
+// or up to the next leader, whichever comes first
+static block_t *make_block(block_cache_t *c, unsigned int wa)
+{
+    const decoded_instr_t *program = c->program;
+    block_t *ret = (block_t *)malloc(sizeof(block_t));
+    if (ret == NULL) {
+	bail_with_error("Cannot allocate a basic block!");
+    }
+    unsigned int end = wa;
+    do {
+	// a superinstruction never includes a leader or a block's end,
+	// so its length can be skipped
+	bool ends = decode_ends_block(program[end].handler);
+	end += program[end].length;
+	if (ends) {
+	    break;
+	}
+    } while (end < c->program_words && !c->is_leader[end]);
+    ret->first = wa;
+    ret->end = end;
+    ret->count = 0;
+    ret->fallthrough = NULL;
+    ret->taken = NULL;
+    ret->native = NULL;
+    ret->made_before = c->last_made;
+    c->last_made = ret;
+    return ret;
+}
+
+// Requires: wa is less than the count given to blocks_create
+// Return the block in c that starts at word address wa,
+// making it if it is not yet in the cache
+block_t *blocks_lookup(block_cache_t *c, unsigned int wa)
+{
+    if (c->block_at[wa] == NULL) {
+	c->block_at[wa] = make_block(c, wa);
+    }
+    return c->block_at[wa];
+}
+
+// Return the block in c starting at word address wa, which follows b,
+// or NULL if wa is not in the program's text,
+// and remember that block as a successor of b
+block_t *blocks_chain(block_cache_t *c, block_t *b, unsigned int wa)
+{
+    if (wa >= c->program_words) {
+	return NULL;
+    }
+    block_t *next = blocks_lookup(c, wa);
+    if (wa == b->end) {
+	b->fallthrough = next;
+    } else {
+	b->taken = next;
+    }
+    return next;
+}
+
+// Empty the cache c (e.g., because the program's text was changed),
+// keeping the execution counts of the blocks already made
+// (but not their native code, so the JIT can reuse its space)
+void blocks_flush(block_cache_t *c)
+{
+    for (block_t *b = c->last_made; b != NULL; b = b->made_before) {
+	b->fallthrough = NULL;
+	b->taken = NULL;
+	b->native = NULL;
+    }
+    for (unsigned int i = 0; i < c->program_words; i++) {
+	c->block_at[i] = NULL;
+    }
+}
+
+// Return a negative number, 0, or a positive number
+// as the block pointed to by p starts before, at, or after
+// the one pointed to by q (for qsort)
+static int compare_blocks(const void *p, const void *q)
+{
+    const block_t *b1 = *(const block_t * const *)p;
+    const block_t *b2 = *(const block_t * const *)q;
+    if (b1->first != b2->first) {
+	return (b1->first < b2->first) ? -1 : 1;
+    }
+    return (b1->end < b2->end) ? -1 : (b1->end > b2->end);
+}
+
+// Print the execution count of each block made in c to out,
+// in order of the blocks' addresses
+void blocks_print_counts(block_cache_t *c, FILE *out)
+{
+    unsigned int num_blocks = 0;
+    for (block_t *b = c->last_made; b != NULL; b = b->made_before) {
+	num_blocks++;
+    }
+    block_t **sorted = (block_t **)malloc(num_blocks * sizeof(block_t *));
+    if (sorted == NULL && num_blocks > 0) {
+	bail_with_error("Cannot allocate space to sort the basic blocks!");
+    }
+    unsigned int i = 0;
+    for (block_t *b = c->last_made; b != NULL; b = b->made_before) {
+	sorted[i++] = b;
+    }
+    qsort(sorted, num_blocks, sizeof(block_t *), compare_blocks);
+    fprintf(out, "Basic block execution counts (%u blocks):\n", num_blocks);
+    fprintf(out, "%8s %8s %12s\n", "first", "last", "count");
+    for (i = 0; i < num_blocks; i++) {
+	fprintf(out, "%8u %8u %12lu\n",
+		sorted[i]->first * BYTES_PER_WORD,
+		(sorted[i]->end - 1) * BYTES_PER_WORD,
+		sorted[i]->count);
+    }
+    free(sorted);
+}
@@ -0,0 +1,66 @@
+/* $Id$ */
+// Basic blocks of the loaded program, for the VM's block engine
+#ifndef _BLOCKS_H
+#define _BLOCKS_H
+#include <stdio.h>
+#include <stdbool.h>
+#include "decode.h"
+
+// native code made by the JIT (see jit.h) for a block,
+// which returns the word address of the first instruction
+// in the block that it did not execute
+typedef unsigned int (*native_code_t)(void);
+
+// a basic block: a sequence of pre-decoded instructions that is
+// only entered at its start and only left after its last instruction
+typedef struct block_s {
+    // word addresses of the first instruction and just past the last one
+    unsigned int first;
+    unsigned int end;
+    // number of times the block has been executed
+    unsigned long count;
+    // the block starting at end, once it has been executed after this one
+    struct block_s *fallthrough;
+    // the block most recently executed after this one,
+    // when this one ended with a control transfer
+    struct block_s *taken;
+    // the block made just before this one (for printing the counts)
+    struct block_s *made_before;
+    // native code for the block, once the JIT has compiled it, or NULL
+    native_code_t native;
+} block_t;
+
+// a cache of the basic blocks of one program (see blocks.c)
+typedef struct block_cache_s block_cache_t;
+
+// Requires: dis and leaders have count elements
+//           (leaders as set by decode_find_leaders),
+//           and they stay allocated while the blocks are used
+// Return a new, empty cache of the basic blocks of the pre-decoded
+// program dis, whose blocks start at the leaders
+extern block_cache_t *blocks_create(const decoded_instr_t *dis,
+				    const bool *leaders, unsigned int count);
+
+// Free the cache c and all of its blocks
+extern void blocks_destroy(block_cache_t *c);
+
+// Requires: wa is less than the count given to blocks_create
+// Return the block in c that starts at word address wa,
+// making it if it is not yet in the cache
+extern block_t *blocks_lookup(block_cache_t *c, unsigned int wa);
+
+// Return the block in c starting at word address wa, which follows b,
+// or NULL if wa is not in the program's text,
+// and remember that block as a successor of b
+extern block_t *blocks_chain(block_cache_t *c, block_t *b, unsigned int wa);
+
+// Empty the cache c (e.g., because the program's text was changed),
+// keeping the execution counts of the blocks already made
+// (but not their native code, so the JIT can reuse its space)
+extern void blocks_flush(block_cache_t *c);
+
+// Print the execution count of each block made in c to out,
+// in order of the blocks' addresses
+extern void blocks_print_counts(block_cache_t *c, FILE *out);
+
+#endif
@@ -40,6 +40,15 @@ word_type bof_read_word(BOFFILE bf)
     return b.w;
 }
 
+// Requires: bf is open for reading in binary and
+//           buf has room for at least count words
+// Read up to count words from bf into buf (with one read),
+// and return the number of words read
+size_t bof_read_words(BOFFILE bf, size_t count, word_type *buf)
+{
+    return fread(buf, BYTES_PER_WORD, count, bf.fileptr);
+}
+
 // Requires: bf.fileptr is open for reading in binary
 // and buf is of size at least bytes
 // Read the given number of bytes into buf and return the number of bytes read
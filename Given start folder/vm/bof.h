@@ -33,6 +33,12 @@ extern BOFFILE bof_read_open(const char *filename);
 // Return the next word from bf
 extern word_type bof_read_word(BOFFILE bf);
 
+// Requires: bf is open for reading in binary and
+//           buf has room for at least count words
+// Read up to count words from bf into buf (with one read),
+// and return the number of words read
+extern size_t bof_read_words(BOFFILE bf, size_t count, word_type *buf);
+
 // Requires: bf is open for reading in binary and
 // buf is of size at least bytes
 // Read the given number of bytes into buf and return the number of bytes read
@@ -0,0 +1,472 @@
+/* $Id$ */
+// The C program generated for a BOF file has a single function, main,
+// with the SRM's registers as local variables and a label (a%d, where
+// %d is the byte address, as in the disassembler) on each instruction
+// that a branch, jump, or return can go to. Branches and jumps become
+// gotos, and JR goes through a switch on the target address,
+// which the C compiler makes into a dispatch table.
+// Only the registers that some instruction reads are declared,
+// and results that are never read are not assigned,
+// so the generated code compiles without warnings.
+#include <stdio.h>
+#include <stdbool.h>
+#include "bof2c.h"
+#include "bof.h"
+#include "decode.h"
+#include "instruction.h"
+#include "machine.h"
+#include "regname.h"
+#include "utilities.h"
+
+// the program being translated, as read from the BOF file
+static BOFHeader header;
+static unsigned int text_words;
+static wordAsInstr_t text[MEMORY_SIZE_IN_WORDS];
+static unsigned int data_words;
+static word_type data[MEMORY_SIZE_IN_WORDS];
+
+// which instructions get labels in the generated code
+static bool labeled[MEMORY_SIZE_IN_WORDS];
+
+// the indexes of HI and LO in is_read (after the GPRs)
+#define HI_INDEX NUM_REGISTERS
+#define LO_INDEX (NUM_REGISTERS + 1)
+
+// which registers are read by some instruction
+// (so need to be declared and assigned in the generated code)
+static bool is_read[NUM_REGISTERS + 2];
+
+// Requires: bf is open for reading and positioned after its header
+// Read the text and data sections of bf
+static void read_sections(BOFFILE bf)
+{
+    text_words = header.text_length / BYTES_PER_WORD;
+    data_words = header.data_length / BYTES_PER_WORD;
+    if (text_words > MEMORY_SIZE_IN_WORDS
+	|| header.data_start_address / BYTES_PER_WORD + data_words
+	   > MEMORY_SIZE_IN_WORDS) {
+	bail_with_error("The program in %s does not fit in the SRM's memory!",
+			bf.filename);
+    }
+    for (unsigned int i = 0; i < text_words; i++) {
+	text[i].bi = instruction_read(bf);
+    }
+    for (unsigned int i = 0; i < data_words; i++) {
+	data[i] = bof_read_word(bf);
+    }
+}
+
+// Return the pre-decoded form of the instruction at word address i
+static decoded_instr_t decoded_at(unsigned int i)
+{
+    return decode_instr(text[i].bi, i * BYTES_PER_WORD);
+}
+
+// Label the start address, the targets of branches and jumps,
+// and the return address of each JAL (all that are in the text)
+static void find_labels()
+{
+    for (unsigned int i = 0; i < text_words; i++) {
+	labeled[i] = (i * BYTES_PER_WORD == header.text_start_address);
+    }
+    for (unsigned int i = 0; i < text_words; i++) {
+	decoded_instr_t di = decoded_at(i);
+	switch (di.handler) {
+	case BEQ_H: case BGEZ_H: case BGTZ_H: case BLEZ_H: case BLTZ_H:
+	case BNE_H: case JMP_H:
+	    if (di.target / BYTES_PER_WORD < text_words) {
+		labeled[di.target / BYTES_PER_WORD] = true;
+	    }
+	    break;
+	case JAL_H:
+	    if (di.target / BYTES_PER_WORD < text_words) {
+		labeled[di.target / BYTES_PER_WORD] = true;
+	    }
+	    if (i + 1 < text_words) {
+		labeled[i + 1] = true;
+	    }
+	    break;
+	default:
+	    break;
+	}
+    }
+}
+
+// Note which registers are read by the instructions of the text
+// (in the same cases as print_instr reads them)
+static void find_reads()
+{
+    for (int r = 0; r < NUM_REGISTERS + 2; r++) {
+	is_read[r] = false;
+    }
+    for (unsigned int i = 0; i < text_words; i++) {
+	decoded_instr_t di = decoded_at(i);
+	switch (di.handler) {
+	case ADD_H: case SUB_H: case MUL_H: case DIV_H:
+	case AND_H: case BOR_H: case NOR_H: case XOR_H:
+	case SW_H: case SB_H:
+	    is_read[di.rs] = true;
+	    is_read[di.rt] = true;
+	    break;
+	case BEQ_H: case BNE_H:
+	    // (comparing a register with itself does not need its value)
+	    if (di.rs != di.rt) {
+		is_read[di.rs] = true;
+		is_read[di.rt] = true;
+	    }
+	    break;
+	case SLL_H: case SRL_H:
+	    is_read[di.rt] = true;
+	    break;
+	case JR_H: case ADDI_H: case ANDI_H: case BORI_H: case XORI_H:
+	case BGEZ_H: case BGTZ_H: case BLEZ_H: case BLTZ_H:
+	case LBU_H: case LW_H:
+	    is_read[di.rs] = true;
+	    break;
+	case MFHI_H:
+	    is_read[HI_INDEX] = true;
+	    break;
+	case MFLO_H:
+	    is_read[LO_INDEX] = true;
+	    break;
+	case PSTR_H: case PINT_H: case PCH_H:
+	    is_read[A0] = true;
+	    break;
+	default:
+	    break;
+	}
+    }
+}
+
+// Print the start of the generated program, up to main, to out
+static void print_prelude(FILE *out, const char *name)
+{
+    fprintf(out, "/* Generated by bof2c from %s; do not edit */\n", name);
+    fprintf(out, "#include <stdio.h>\n#include <stdlib.h>\n\n");
+    fprintf(out, "#define MEMORY_SIZE_IN_BYTES %d\n", MEMORY_SIZE_IN_BYTES);
+    fprintf(out, "#define MEMORY_SIZE_IN_WORDS %d\n\n", MEMORY_SIZE_IN_WORDS);
+    fprintf(out, "// the SRM's memory, holding the program's text and data\n");
+    fprintf(out, "static union {\n");
+    fprintf(out, "    unsigned char bytes[MEMORY_SIZE_IN_BYTES];\n");
+    fprintf(out, "    int words[MEMORY_SIZE_IN_WORDS];\n");
+    fprintf(out, "} memory = { .words = {\n");
+    for (unsigned int i = 0; i < text_words; i++) {
+	if (text[i].w != 0) {
+	    fprintf(out, "    [%u] = %d,\n", i, text[i].w);
+	}
+    }
+    unsigned int data_base = header.data_start_address / BYTES_PER_WORD;
+    for (unsigned int i = 0; i < data_words; i++) {
+	if (data[i] != 0) {
+	    fprintf(out, "    [%u] = %d,\n", data_base + i, data[i]);
+	}
+    }
+    fprintf(out, "} };\n\n");
+    fprintf(out, "// Print msg and a newline on stderr, as the VM does,"
+	    " and exit with a failure code\n");
+    fprintf(out, "static void bail(const char *msg)\n{\n");
+    fprintf(out, "    fflush(stdout);\n");
+    fprintf(out, "    fprintf(stderr, \"%%s\\n\", msg);\n");
+    fprintf(out, "    exit(EXIT_FAILURE);\n}\n\n");
+}
+
+// Print the start of main, which declares and initializes
+// the registers that are read
+static void print_main_start(FILE *out)
+{
+    fprintf(out, "int main()\n{\n");
+    for (int r = 0; r < NUM_REGISTERS; r++) {
+	if (!is_read[r]) {
+	    continue;
+	}
+	unsigned int init = 0;
+	switch (r) {
+	case GP:
+	    init = header.data_start_address;
+	    break;
+	case SP: case FP: case A0:
+	    init = header.stack_bottom_addr;
+	    break;
+	default:
+	    break;
+	}
+	fprintf(out, "    int r%d = %u; // %s\n", r, init, regname_get(r));
+    }
+    if (is_read[HI_INDEX]) {
+	fprintf(out, "    int hi = 0;\n");
+    }
+    if (is_read[LO_INDEX]) {
+	fprintf(out, "    int lo = 0;\n");
+    }
+    fprintf(out, "    unsigned int pc;\n\n");
+    fprintf(out, "    pc = %u;\n", header.text_start_address);
+    fprintf(out, "    goto dispatch;\n");
+}
+
+// Print the label to go to for the byte address addr, if it is labeled,
+// and otherwise code to go there through the dispatch table
+static void print_goto(FILE *out, address_type addr)
+{
+    if (addr / BYTES_PER_WORD < text_words && addr % BYTES_PER_WORD == 0
+	&& labeled[addr / BYTES_PER_WORD]) {
+	fprintf(out, "goto a%u;", addr);
+    } else {
+	fprintf(out, "{ pc = %u; goto dispatch; }", addr);
+    }
+}
+
+// Print a conditional branch to the target of di, if cond holds
+static void print_branch(FILE *out, const decoded_instr_t *di,
+			 const char *cond)
+{
+    fprintf(out, "if (%s) ", cond);
+    print_goto(out, di->target);
+}
+
+// Return the register that the instruction di only computes a value
+// for (with no other effects), or -1 if it is not such an instruction
+static int result_register(const decoded_instr_t *di)
+{
+    switch (di->handler) {
+    case ADD_H: case SUB_H: case AND_H: case BOR_H: case NOR_H: case XOR_H:
+    case SLL_H: case SRL_H: case MFHI_H: case MFLO_H:
+	return di->rd;
+    case ADDI_H: case ANDI_H: case BORI_H: case XORI_H: case LBU_H: case LW_H:
+	return di->rt;
+    case MUL_H:
+	return (is_read[HI_INDEX] || !is_read[LO_INDEX]) ? HI_INDEX : LO_INDEX;
+    default:
+	return -1;
+    }
+}
+
+// Print an assignment of the result of a system call to $v0 to out,
+// if $v0 is read
+static void print_v0_assignment(FILE *out)
+{
+    if (is_read[V0]) {
+	fprintf(out, "r%d = ", V0);
+    }
+}
+
+// Print the C code for the instruction at word address i to out
+static void print_instr(FILE *out, unsigned int i)
+{
+    decoded_instr_t di = decoded_at(i);
+    int s = di.rs, t = di.rt, d = di.rd;
+    char cond[64];
+    if (labeled[i]) {
+	fprintf(out, " a%u:", i * BYTES_PER_WORD);
+    }
+    fprintf(out, "\t// %s\n\t", instruction_assembly_form(text[i].bi));
+    int result = result_register(&di);
+    if (result >= 0 && !is_read[result]) {
+	fprintf(out, "; // its result is never read");
+	newline(out);
+	return;
+    }
+    switch (di.handler) {
+    case ADD_H:
+	fprintf(out, "r%d = (int)((unsigned)r%d + (unsigned)r%d);", d, s, t);
+	break;
+    case SUB_H:
+	fprintf(out, "r%d = (int)((unsigned)r%d - (unsigned)r%d);", d, s, t);
+	break;
+    case MUL_H:
+	if (is_read[LO_INDEX]) {
+	    fprintf(out, "lo = (int)((unsigned)r%d * (unsigned)r%d);", s, t);
+	}
+	if (is_read[HI_INDEX]) {
+	    fprintf(out, " hi = ((int)((unsigned)r%d * (unsigned)r%d) < 0)"
+		    " ? -1 : 0;", s, t);
+	}
+	break;
+    case DIV_H:
+	fprintf(out, "if (r%d == 0) { bail(\"Attempt to divide by zero!\"); }",
+		t);
+	if (is_read[HI_INDEX]) {
+	    fprintf(out, " hi = r%d %% r%d;", s, t);
+	}
+	if (is_read[LO_INDEX]) {
+	    fprintf(out, " lo = r%d / r%d;", s, t);
+	}
+	break;
+    case MFHI_H:
+	fprintf(out, "r%d = hi;", d);
+	break;
+    case MFLO_H:
+	fprintf(out, "r%d = lo;", d);
+	break;
+    case AND_H:
+	fprintf(out, "r%d = r%d & r%d;", d, s, t);
+	break;
+    case BOR_H:
+	fprintf(out, "r%d = r%d | r%d;", d, s, t);
+	break;
+    case NOR_H:
+	fprintf(out, "r%d = ~(r%d | r%d);", d, s, t);
+	break;
+    case XOR_H:
+	fprintf(out, "r%d = r%d ^ r%d;", d, s, t);
+	break;
+    case SLL_H:
+	fprintf(out, "r%d = (int)((unsigned)r%d << %d);", d, t, di.shift);
+	break;
+    case SRL_H:
+	fprintf(out, "r%d = (int)((unsigned)r%d >> %d);", d, t, di.shift);
+	break;
+    case JR_H:
+	fprintf(out, "pc = r%d; goto dispatch;", s);
+	break;
+    case ADDI_H:
+	fprintf(out, "r%d = (int)((unsigned)r%d + (unsigned)%d);",
+		t, s, di.immed);
+	break;
+    case ANDI_H:
+	fprintf(out, "r%d = r%d & %d;", t, s, di.immed);
+	break;
+    case BORI_H:
+	fprintf(out, "r%d = r%d | %d;", t, s, di.immed);
+	break;
+    case XORI_H:
+	fprintf(out, "r%d = r%d ^ %d;", t, s, di.immed);
+	break;
+    case BEQ_H:
+	if (s == t) {
+	    // (the compiler's unconditional jump)
+	    print_goto(out, di.target);
+	    break;
+	}
+	sprintf(cond, "r%d == r%d", s, t);
+	print_branch(out, &di, cond);
+	break;
+    case BGEZ_H:
+	sprintf(cond, "r%d >= 0", s);
+	print_branch(out, &di, cond);
+	break;
+    case BGTZ_H:
+	sprintf(cond, "r%d > 0", s);
+	print_branch(out, &di, cond);
+	break;
+    case BLEZ_H:
+	sprintf(cond, "r%d <= 0", s);
+	print_branch(out, &di, cond);
+	break;
+    case BLTZ_H:
+	sprintf(cond, "r%d < 0", s);
+	print_branch(out, &di, cond);
+	break;
+    case BNE_H:
+	if (s == t) {
+	    fprintf(out, "; // never taken");
+	    break;
+	}
+	sprintf(cond, "r%d != r%d", s, t);
+	print_branch(out, &di, cond);
+	break;
+    case LBU_H:
+	fprintf(out, "r%d = memory.bytes[(unsigned)(r%d + %d)];",
+		t, s, di.immed);
+	break;
+    case LW_H:
+	fprintf(out, "r%d = memory.words[(unsigned)((r%d + %d) / 4)];",
+		t, s, di.immed);
+	break;
+    case SB_H:
+	fprintf(out, "memory.bytes[(unsigned)(r%d + %d)] = r%d;",
+		s, di.immed, t);
+	break;
+    case SW_H:
+	fprintf(out, "memory.words[(unsigned)((r%d + %d) / 4)] = r%d;",
+		s, di.immed, t);
+	break;
+    case JMP_H:
+	print_goto(out, di.target);
+	break;
+    case JAL_H:
+	if (is_read[RA]) {
+	    fprintf(out, "r%d = %u; ", RA, (i + 1) * BYTES_PER_WORD);
+	}
+	print_goto(out, di.target);
+	break;
+    case EXIT_H:
+	fprintf(out, "exit(0);");
+	break;
+    case PSTR_H:
+	print_v0_assignment(out);
+	fprintf(out, "printf(\"%%s\", &memory.bytes[r%d]);", A0);
+	break;
+    case PINT_H:
+	print_v0_assignment(out);
+	fprintf(out, "printf(\"%%d\", r%d);", A0);
+	break;
+    case PCH_H:
+	print_v0_assignment(out);
+	fprintf(out, "fputc(r%d, stdout);", A0);
+	break;
+    case RCH_H:
+	print_v0_assignment(out);
+	fprintf(out, "getc(stdin);");
+	break;
+    case STRA_H: case NOTR_H:
+	fprintf(out, "; // tracing is not supported");
+	break;
+    case BAD_FUNC_H:
+	fprintf(out, "bail(\"Invalid function code (%d) in machine_execute's"
+		" register instruction case!\");", di.immed);
+	break;
+    case BAD_SYSCALL_H:
+	fprintf(out, "bail(\"Invalid system call type (%d) in machine_execute's"
+		" syscall instruction case!\");", di.immed);
+	break;
+    case BAD_OP_H:
+	fprintf(out, "bail(\"Invalid opcode (%d) in machine_execute's"
+		" immediate instruction case!\");", di.immed);
+	break;
+    default:
+	fprintf(out, "bail(\"Invalid instruction type (%d) in"
+		" machine_execute!\");", di.immed);
+	break;
+    }
+    newline(out);
+}
+
+// Print the end of main: what happens after the last instruction
+// and the dispatch table for jumps to computed addresses
+static void print_main_end(FILE *out)
+{
+    fprintf(out, "\tpc = %u;\n", text_words * BYTES_PER_WORD);
+    fprintf(out, " dispatch:\n");
+    fprintf(out, "    switch (pc) {\n");
+    for (unsigned int i = 0; i < text_words; i++) {
+	if (labeled[i]) {
+	    fprintf(out, "    case %u: goto a%u;\n",
+		    i * BYTES_PER_WORD, i * BYTES_PER_WORD);
+	}
+    }
+    fprintf(out, "    default:\n");
+    fprintf(out, "\tfprintf(stderr, \"bof2c: no code for address %%u\\n\","
+	    " pc);\n");
+    fprintf(out, "\tbail(\"(only addresses of labels can be jumped to)\");\n");
+    fprintf(out, "    }\n");
+    fprintf(out, "    return EXIT_SUCCESS;\n}\n");
+}
+
+// Translate the program in bf into a self-contained C program
+// (named name in comments), with output going to the file out.
+// The C program runs like the VM does on the program,
+// except that it does not trace and stores into the text
+// do not change the code that runs.
+void bof2cProgram(FILE *out, BOFFILE bf, const char *name)
+{
+    header = bof_read_header(bf);
+    read_sections(bf);
+    find_labels();
+    find_reads();
+    print_prelude(out, name);
+    print_main_start(out);
+    for (unsigned int i = 0; i < text_words; i++) {
+	print_instr(out, i);
+    }
+    print_main_end(out);
+}
@@ -0,0 +1,15 @@
+/* $Id$ */
+// Translation of binary object files into C programs
+#ifndef _BOF2C_H
+#define _BOF2C_H
+#include <stdio.h>
+#include "bof.h"
+
+// Translate the program in bf into a self-contained C program
+// (named name in comments), with output going to the file out.
+// The C program runs like the VM does on the program,
+// except that it does not trace and stores into the text
+// do not change the code that runs.
+extern void bof2cProgram(FILE *out, BOFFILE bf, const char *name);
+
+#endif
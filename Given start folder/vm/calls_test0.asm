@@ -0,0 +1,33 @@
+	# $Id$
+	# nested and recursive calls, for testing the profiler's
+	# counts for each stack of calls (in file.prof.folded)
+	.text start
+start:	ADDI $0, $t0, 3      # $t0 is the depth of r's recursion
+	JAL f
+	JAL f
+	JAL r
+	ADDI $0, $a0, 10     # print a newline
+	PCH
+	EXIT
+f:	ADDI $sp, $sp, -4    # push $ra
+	SW $sp, $ra, 0
+	JAL g
+	JAL g
+	LW $sp, $ra, 0       # pop $ra
+	ADDI $sp, $sp, 4
+	JR $ra
+g:	ADDI $0, $a0, 103    # print a g
+	PCH
+	JR $ra
+r:	BLEZ $t0, 6          # to rdone when $t0 <= 0
+	ADDI $t0, $t0, -1
+	ADDI $sp, $sp, -4    # push $ra
+	SW $sp, $ra, 0
+	JAL r
+	LW $sp, $ra, 0       # pop $ra
+	ADDI $sp, $sp, 4
+rdone:	JR $ra
+	.data 1024
+	WORD unused = 0
+	.stack 4096
+	.end
@@ -0,0 +1,435 @@
+/* $Id$ */
+#include <stddef.h>
+#include <stdbool.h>
+#include "decode.h"
+#include "machine_types.h"
+#include "regname.h"
+
+// Return the pre-decoded form of a register-format instruction ri
+static decoded_instr_t decode_reg_instr(reg_instr_t ri)
+{
+    decoded_instr_t di = { BAD_FUNC_H, ri.rs, ri.rt, ri.rd, ri.shift, 0, 0, NULL };
+    switch (ri.func) {
+    case ADD_F:
+	di.handler = ADD_H;
+	break;
+    case SUB_F:
+	di.handler = SUB_H;
+	break;
+    case MUL_F:
+	di.handler = MUL_H;
+	break;
+    case DIV_F:
+	di.handler = DIV_H;
+	break;
+    case MFHI_F:
+	di.handler = MFHI_H;
+	break;
+    case MFLO_F:
+	di.handler = MFLO_H;
+	break;
+    case AND_F:
+	di.handler = AND_H;
+	break;
+    case BOR_F:
+	di.handler = BOR_H;
+	break;
+    case NOR_F:
+	di.handler = NOR_H;
+	break;
+    case XOR_F:
+	di.handler = XOR_H;
+	break;
+    case SLL_F:
+	di.handler = SLL_H;
+	break;
+    case SRL_F:
+	di.handler = SRL_H;
+	break;
+    case JR_F:
+	di.handler = JR_H;
+	break;
+    default:
+	di.immed = ri.func;
+	break;
+    }
+    return di;
+}
+
+// Return the pre-decoded form of the system call instruction bi
+static decoded_instr_t decode_syscall_instr(bin_instr_t bi)
+{
+    decoded_instr_t di = { BAD_SYSCALL_H, 0, 0, 0, 0, 0, 0, NULL };
+    switch (instruction_syscall_number(bi)) {
+    case exit_sc:
+	di.handler = EXIT_H;
+	break;
+    case print_str_sc:
+	di.handler = PSTR_H;
+	break;
+    case print_int_sc:
+	di.handler = PINT_H;
+	break;
+    case print_char_sc:
+	di.handler = PCH_H;
+	break;
+    case read_char_sc:
+	di.handler = RCH_H;
+	break;
+    case start_tracing_sc:
+	di.handler = STRA_H;
+	break;
+    case stop_tracing_sc:
+	di.handler = NOTR_H;
+	break;
+    default:
+	di.immed = instruction_syscall_number(bi);
+	break;
+    }
+    return di;
+}
+
+// Return the pre-decoded form of the immediate-format instruction ii,
+// which is located at byte address addr
+static decoded_instr_t decode_immed_instr(immed_instr_t ii, address_type addr)
+{
+    decoded_instr_t di = { BAD_OP_H, ii.rs, ii.rt, 0, 0, 0, 0, NULL };
+    // branches are relative to the already incremented PC
+    address_type next_pc = addr + BYTES_PER_WORD;
+    switch (ii.op) {
+    case ADDI_O:
+	di.handler = ADDI_H;
+	di.immed = machine_types_sgnExt(ii.immed);
+	break;
+    case ANDI_O:
+	di.handler = ANDI_H;
+	di.immed = machine_types_zeroExt(ii.immed);
+	break;
+    case BORI_O:
+	di.handler = BORI_H;
+	di.immed = machine_types_zeroExt(ii.immed);
+	break;
+    case XORI_O:
+	di.handler = XORI_H;
+	di.immed = machine_types_zeroExt(ii.immed);
+	break;
+    case BEQ_O:
+	di.handler = BEQ_H;
+	di.target = next_pc + machine_types_formOffset(ii.immed);
+	break;
+    case BGEZ_O:
+	di.handler = BGEZ_H;
+	di.target = next_pc + machine_types_formOffset(ii.immed);
+	break;
+    case BGTZ_O:
+	di.handler = BGTZ_H;
+	di.target = next_pc + machine_types_formOffset(ii.immed);
+	break;
+    case BLEZ_O:
+	di.handler = BLEZ_H;
+	di.target = next_pc + machine_types_formOffset(ii.immed);
+	break;
+    case BLTZ_O:
+	di.handler = BLTZ_H;
+	di.target = next_pc + machine_types_formOffset(ii.immed);
+	break;
+    case BNE_O:
+	di.handler = BNE_H;
+	di.target = next_pc + machine_types_formOffset(ii.immed);
+	break;
+    case LBU_O:
+	di.handler = LBU_H;
+	di.immed = machine_types_formOffset(ii.immed);
+	break;
+    case LW_O:
+	di.handler = LW_H;
+	di.immed = machine_types_formOffset(ii.immed);
+	break;
+    case SB_O:
+	di.handler = SB_H;
+	di.immed = machine_types_formOffset(ii.immed);
+	break;
+    case SW_O:
+	di.handler = SW_H;
+	di.immed = machine_types_formOffset(ii.immed);
+	break;
+    default:
+	di.immed = ii.op;
+	break;
+    }
+    return di;
+}
+
+// Return the pre-decoded form of the jump instruction ji,
+// which is located at byte address addr
+static decoded_instr_t decode_jump_instr(jump_instr_t ji, address_type addr)
+{
+    decoded_instr_t di = { BAD_OP_H, 0, 0, 0, 0, 0, 0, NULL };
+    address_type next_pc = addr + BYTES_PER_WORD;
+    switch (ji.op) {
+    case JMP_O:
+	di.handler = JMP_H;
+	di.target = machine_types_formAddress(next_pc, ji.addr);
+	break;
+    case JAL_O:
+	di.handler = JAL_H;
+	di.target = machine_types_formAddress(next_pc, ji.addr);
+	break;
+    default:
+	di.immed = ji.op;
+	break;
+    }
+    return di;
+}
+
+// Return the pre-decoded form of bi, which is located at byte address addr
+// (the address is needed to precompute branch and jump targets)
+decoded_instr_t decode_instr(bin_instr_t bi, address_type addr)
+{
+    decoded_instr_t di = { BAD_TYPE_H, 0, 0, 0, 0, 0, 0, NULL };
+    instr_type it = instruction_type(bi);
+    switch (it) {
+    case reg_instr_type:
+	di = decode_reg_instr(bi.reg);
+	break;
+    case syscall_instr_type:
+	di = decode_syscall_instr(bi);
+	break;
+    case immed_instr_type:
+	di = decode_immed_instr(bi.immed, addr);
+	break;
+    case jump_instr_type:
+	di = decode_jump_instr(bi.jump, addr);
+	break;
+    default:
+	di.immed = it;
+	break;
+    }
+    di.length = 1;
+    return di;
+}
+
+// Requires: dis has room for count elements
+// Pre-decode the count instructions in instrs (starting at address 0)
+// into dis
+void decode_program(const bin_instr_t *instrs, unsigned int count,
+		    decoded_instr_t *dis)
+{
+    for (unsigned int i = 0; i < count; i++) {
+	dis[i] = decode_instr(instrs[i], i * BYTES_PER_WORD);
+    }
+}
+
+// Is h the handler of an instruction that ends a basic block,
+// i.e., a branch, jump, or system call?
+bool decode_ends_block(handler_id h)
+{
+    switch (h) {
+    case JR_H:
+    case BEQ_H: case BGEZ_H: case BGTZ_H: case BLEZ_H: case BLTZ_H: case BNE_H:
+    case JMP_H: case JAL_H:
+    case EXIT_H: case PSTR_H: case PINT_H: case PCH_H: case RCH_H:
+    case STRA_H: case NOTR_H:
+	return true;
+	break;
+    default:
+	return false;
+	break;
+    }
+}
+
+// Is h the handler of a conditional branch?
+bool decode_is_branch(handler_id h)
+{
+    switch (h) {
+    case BEQ_H: case BGEZ_H: case BGTZ_H: case BLEZ_H: case BLTZ_H: case BNE_H:
+	return true;
+	break;
+    default:
+	return false;
+	break;
+    }
+}
+
+// the names of the handlers, indexed by handler_id
+static const char *handler_names[NUM_HANDLERS] = {
+    [ADD_H] = "ADD", [SUB_H] = "SUB", [MUL_H] = "MUL", [DIV_H] = "DIV",
+    [MFHI_H] = "MFHI", [MFLO_H] = "MFLO", [AND_H] = "AND", [BOR_H] = "BOR",
+    [NOR_H] = "NOR", [XOR_H] = "XOR", [SLL_H] = "SLL", [SRL_H] = "SRL",
+    [JR_H] = "JR",
+    [ADDI_H] = "ADDI", [ANDI_H] = "ANDI", [BORI_H] = "BORI", [XORI_H] = "XORI",
+    [BEQ_H] = "BEQ", [BGEZ_H] = "BGEZ", [BGTZ_H] = "BGTZ",
+    [BLEZ_H] = "BLEZ", [BLTZ_H] = "BLTZ", [BNE_H] = "BNE",
+    [LBU_H] = "LBU", [LW_H] = "LW", [SB_H] = "SB", [SW_H] = "SW",
+    [JMP_H] = "JMP", [JAL_H] = "JAL",
+    [EXIT_H] = "EXIT", [PSTR_H] = "PSTR", [PINT_H] = "PINT", [PCH_H] = "PCH",
+    [RCH_H] = "RCH", [STRA_H] = "STRA", [NOTR_H] = "NOTR",
+    [BAD_FUNC_H] = "(bad function code)",
+    [BAD_SYSCALL_H] = "(bad system call)",
+    [BAD_OP_H] = "(bad opcode)", [BAD_TYPE_H] = "(bad instruction type)",
+    [PUSH_H] = "(push)", [POP_H] = "(pop)", [LW_PUSH_H] = "(LW, push)",
+    [POP2_ADD_PUSH_H] = "(pop 2, ADD, push)",
+    [POP2_SUB_PUSH_H] = "(pop 2, SUB, push)",
+    [ADD_LW_H] = "(ADD, LW)", [ADD_SW_H] = "(ADD, SW)"
+};
+
+// Return the name of h: the mnemonic of the instruction it executes,
+// or a description in parentheses for error and superinstruction handlers
+const char *decode_handler_name(handler_id h)
+{
+    if (h >= NUM_HANDLERS) {
+	return "(unknown handler)";
+    }
+    return handler_names[h];
+}
+
+// Is h the handler of a branch or jump with a target known when decoding?
+static bool has_target(handler_id h)
+{
+    switch (h) {
+    case BEQ_H: case BGEZ_H: case BGTZ_H: case BLEZ_H: case BLTZ_H: case BNE_H:
+    case JMP_H: case JAL_H:
+	return true;
+	break;
+    default:
+	return false;
+	break;
+    }
+}
+
+// Requires: dis and leaders have count elements
+// Set leaders[i] to true if the pre-decoded instruction dis[i]
+// starts a basic block (i.e., it is the first instruction,
+// the target of a branch or jump, or follows an instruction
+// that ends a basic block), and to false otherwise
+void decode_find_leaders(const decoded_instr_t *dis, unsigned int count,
+			 bool *leaders)
+{
+    for (unsigned int i = 0; i < count; i++) {
+	leaders[i] = (i == 0);
+    }
+    for (unsigned int i = 0; i < count; i++) {
+	if (!decode_ends_block(dis[i].handler)) {
+	    continue;
+	}
+	if (i+1 < count) {
+	    leaders[i+1] = true;
+	}
+	if (has_target(dis[i].handler)) {
+	    address_type t = dis[i].target / BYTES_PER_WORD;
+	    if (t < count) {
+		leaders[t] = true;
+	    }
+	}
+    }
+}
+
+// Is the sequence at d, of which there are left instructions,
+// "ADDI $sp, $sp, -4; SW $sp, r, 0" (a push of r)?
+static bool is_push(const decoded_instr_t *d, unsigned int left)
+{
+    return left >= 2
+	&& d[0].handler == ADDI_H && d[0].rs == SP && d[0].rt == SP
+	&& d[0].immed == -BYTES_PER_WORD
+	&& d[1].handler == SW_H && d[1].rs == SP && d[1].immed == 0;
+}
+
+// Is the sequence at d, of which there are left instructions,
+// "LW $sp, r, 0; ADDI $sp, $sp, 4" (a pop into r)?
+static bool is_pop(const decoded_instr_t *d, unsigned int left)
+{
+    return left >= 2
+	&& d[0].handler == LW_H && d[0].rs == SP && d[0].immed == 0
+	&& d[1].handler == ADDI_H && d[1].rs == SP && d[1].rt == SP
+	&& d[1].immed == BYTES_PER_WORD;
+}
+
+// Return the superinstruction for the sequence at d,
+// of which there are left instructions,
+// or d[0] if the sequence does not start with a fusable pattern
+static decoded_instr_t fuse(const decoded_instr_t *d, unsigned int left)
+{
+    decoded_instr_t di = d[0];
+    // pop a; pop b; ADD/SUB rs, rt, rd; push rd
+    if (is_pop(d, left) && is_pop(d+2, left-2) && left >= 7
+	&& (d[4].handler == ADD_H || d[4].handler == SUB_H)
+	&& is_push(d+5, left-5) && d[6].rt == d[4].rd) {
+	di = d[4];
+	di.handler = (d[4].handler == ADD_H) ? POP2_ADD_PUSH_H : POP2_SUB_PUSH_H;
+	di.ra = d[0].rt;
+	di.rb = d[2].rt;
+	di.length = 7;
+    } else if (d[0].handler == LW_H && is_push(d+1, left-1)
+	       && d[2].rt == d[0].rt) {
+	// LW rs, rt, o; push rt
+	di.handler = LW_PUSH_H;
+	di.length = 3;
+    } else if (is_push(d, left)) {
+	di = d[1];
+	di.handler = PUSH_H;
+	di.length = 2;
+    } else if (is_pop(d, left)) {
+	di.handler = POP_H;
+	di.length = 2;
+    } else if (d[0].handler == ADD_H && left >= 2
+	       && (d[1].handler == LW_H || d[1].handler == SW_H)
+	       && d[1].rs == d[0].rd) {
+	// ADD rs, rt, rd; LW/SW rd, rb, o
+	di.handler = (d[1].handler == LW_H) ? ADD_LW_H : ADD_SW_H;
+	di.rb = d[1].rt;
+	di.immed = d[1].immed;
+	di.length = 2;
+    }
+    return di;
+}
+
+// Requires: leaders has count elements
+// Return the number of instructions starting at word address i
+// that a superinstruction at i may stand for
+// (which stops before the next leader)
+static unsigned int fusable(unsigned int count, const bool *leaders,
+			    unsigned int i)
+{
+    unsigned int left = 1;
+    while (left < MAX_FUSED_INSTRS && i + left < count
+	   && !leaders[i + left]) {
+	left++;
+    }
+    return left;
+}
+
+// Requires: leaders has count elements (as set by decode_find_leaders)
+// Return the pre-decoded form of the instruction at word address i
+// of the count instructions in instrs (which start at address 0),
+// which is a superinstruction if the instructions starting at i
+// form one of the sequences that are fused, and otherwise is
+// the same as decode_instr(instrs[i], i * BYTES_PER_WORD).
+// A superinstruction only replaces the first instruction of its sequence,
+// so the VM can still jump to the other instructions in it,
+// and it never includes a leader other than its first instruction.
+decoded_instr_t decode_fused_instr(const bin_instr_t *instrs,
+				   unsigned int count, const bool *leaders,
+				   unsigned int i)
+{
+    decoded_instr_t window[MAX_FUSED_INSTRS];
+    unsigned int left = fusable(count, leaders, i);
+    for (unsigned int j = 0; j < left; j++) {
+	window[j] = decode_instr(instrs[i+j], (i+j) * BYTES_PER_WORD);
+    }
+    return fuse(window, left);
+}
+
+// Requires: dis and leaders have count elements
+//           (leaders as set by decode_find_leaders)
+// Pre-decode the count instructions in instrs (starting at address 0)
+// into dis, fusing frequent sequences into superinstructions
+void decode_program_fused(const bin_instr_t *instrs, unsigned int count,
+			  const bool *leaders, decoded_instr_t *dis)
+{
+    // decode everything first, so each window is only decoded once
+    decode_program(instrs, count, dis);
+    for (unsigned int i = 0; i < count; i++) {
+	// fuse only replaces dis[i], which later windows do not look at
+	dis[i] = fuse(&dis[i], fusable(count, leaders, i));
+    }
+}
@@ -0,0 +1,107 @@
+/* $Id$ */
+// Pre-decoded instructions for the SRM VM's run loop
+#ifndef _DECODE_H
+#define _DECODE_H
+#include <stdbool.h>
+#include "machine_types.h"
+#include "instruction.h"
+
+// handlers for pre-decoded instructions,
+// one per instruction the VM can execute,
+// plus the error cases (which bail when executed, not when decoded)
+typedef enum {ADD_H, SUB_H, MUL_H, DIV_H, MFHI_H, MFLO_H,
+	      AND_H, BOR_H, NOR_H, XOR_H, SLL_H, SRL_H, JR_H,
+	      ADDI_H, ANDI_H, BORI_H, XORI_H,
+	      BEQ_H, BGEZ_H, BGTZ_H, BLEZ_H, BLTZ_H, BNE_H,
+	      LBU_H, LW_H, SB_H, SW_H,
+	      JMP_H, JAL_H,
+	      EXIT_H, PSTR_H, PINT_H, PCH_H, RCH_H, STRA_H, NOTR_H,
+	      BAD_FUNC_H, BAD_SYSCALL_H, BAD_OP_H, BAD_TYPE_H,
+	      // superinstructions, each standing for a sequence of
+	      // instructions that the code generator emits frequently
+	      PUSH_H, POP_H, LW_PUSH_H, POP2_ADD_PUSH_H, POP2_SUB_PUSH_H,
+	      ADD_LW_H, ADD_SW_H,
+	      NUM_HANDLERS
+} handler_id;
+
+// the most instructions that a superinstruction stands for
+#define MAX_FUSED_INSTRS 7
+
+// a pre-decoded instruction, with all fields unpacked
+// and all immediates extended, so no bitfields are read at run time
+typedef struct {
+    handler_id handler;
+    reg_num_type rs;
+    reg_num_type rt;
+    reg_num_type rd;
+    shift_type shift;
+    // the extended immediate, which is the byte offset
+    // for loads and stores, and for the error handlers
+    // the offending opcode, function code, or system call number
+    word_type immed;
+    // byte address of the target for branches and jumps
+    address_type target;
+    // the address of the handler's code, for direct-threaded dispatch
+    // (this is filled in by the VM, not by the decoder)
+    const void *threaded;
+    // extra registers used by some superinstructions
+    reg_num_type ra;
+    reg_num_type rb;
+    // the number of instructions this stands for
+    // (1 for all but superinstructions)
+    unsigned short length;
+} decoded_instr_t;
+
+// Return the pre-decoded form of bi, which is located at byte address addr
+// (the address is needed to precompute branch and jump targets)
+extern decoded_instr_t decode_instr(bin_instr_t bi, address_type addr);
+
+// Requires: dis has room for count elements
+// Pre-decode the count instructions in instrs (starting at address 0)
+// into dis
+extern void decode_program(const bin_instr_t *instrs, unsigned int count,
+			   decoded_instr_t *dis);
+
+// Is h the handler of an instruction that ends a basic block,
+// i.e., a branch, jump, or system call?
+extern bool decode_ends_block(handler_id h);
+
+// Is h the handler of a conditional branch?
+extern bool decode_is_branch(handler_id h);
+
+// Return the name of h: the mnemonic of the instruction it executes,
+// or a description in parentheses for error and superinstruction handlers
+extern const char *decode_handler_name(handler_id h);
+
+// Requires: dis and leaders have count elements
+// Set leaders[i] to true if the pre-decoded instruction dis[i]
+// starts a basic block (i.e., it is the first instruction,
+// the target of a branch or jump, or follows an instruction
+// that ends a basic block), and to false otherwise
+extern void decode_find_leaders(const decoded_instr_t *dis,
+				unsigned int count, bool *leaders);
+
+// Requires: leaders has count elements (as set by decode_find_leaders)
+// Return the pre-decoded form of the instruction at word address i
+// of the count instructions in instrs (which start at address 0),
+// which is a superinstruction if the instructions starting at i
+// form one of the sequences that are fused, and otherwise is
+// the same as decode_instr(instrs[i], i * BYTES_PER_WORD).
+// A superinstruction only replaces the first instruction of its sequence,
+// so the VM can still jump to the other instructions in it,
+// and it never includes a leader other than its first instruction.
+extern decoded_instr_t decode_fused_instr(const bin_instr_t *instrs,
+					  unsigned int count,
+					  const bool *leaders,
+					  unsigned int i);
+
+// Requires: dis and leaders have count elements
+//           (leaders as set by decode_find_leaders)
+// Pre-decode the count instructions in instrs (starting at address 0)
+// into dis, fusing frequent sequences into superinstructions
+extern void decode_program_fused(const bin_instr_t *instrs,
+				 unsigned int count,
+				 const bool *leaders,
+				 decoded_instr_t *dis);
+
+#endif
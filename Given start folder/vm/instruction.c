@@ -13,7 +13,8 @@
 extern char *strdup(const char *s);
 
 // space to hold one instruction's assembly language form
-static char instr_buf[INSTR_BUF_SIZE];
+// (one for each thread, as several threads may trace programs at once)
+static _Thread_local char instr_buf[INSTR_BUF_SIZE];
 
 // Return the type of the instruction given
 instr_type instruction_type(bin_instr_t i) {
@@ -284,7 +285,7 @@ const char *instruction_mnemonic(bin_instr_t i) {
     return NULL;
 }
 
-static char offset_comment_buf[512];
+static _Thread_local char offset_comment_buf[512];
 
 // return a comment string of the form
 // "# offset is +/-d bytes"
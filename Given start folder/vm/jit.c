@@ -0,0 +1,474 @@
+/* $Id$ */
+// The JIT keeps the SRM's registers and memory where the interpreter
+// keeps them, and addresses them from callee-saved host registers:
+//   rbx: the general purpose registers (GPR[r] is at rbx + 4*r)
+//   r12: the VM's memory
+//   r13: the HI and LO registers (LO is at r13, HI at r13 + 4)
+//   r14: the PC
+// so the code for each SRM instruction only uses eax, ecx, and edx.
+#define _DEFAULT_SOURCE
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "jit.h"
+#include "decode.h"
+#include "regname.h"
+#include "utilities.h"
+
+#if defined(__x86_64__) && defined(__linux__)
+
+// the size of the buffer for native code
+#define CODE_BUFFER_BYTES (8 * 1024 * 1024)
+
+// the most bytes of code generated for any instruction,
+// and for the prologue and epilogue of a block
+#define MAX_INSTR_BYTES 48
+#define MAX_FRAME_BYTES 64
+
+struct jit_s {
+    // the buffer for native code, and the number of bytes used in it
+    // (the code made is executable but not writable, and the rest
+    // of the buffer is writable but not executable)
+    byte_type *code_buffer;
+    size_t code_used;
+    // the host's page size, the unit of the buffer's protection
+    size_t page_size;
+    // where the code is being written
+    byte_type *code_next;
+    // the VM's state, as given to jit_create
+    word_type *vm_gpr;
+    word_type *vm_hilo;
+    byte_type *vm_memory;
+    address_type *vm_pc;
+    unsigned int vm_text_bytes;
+};
+
+// Requires: all of the pointers stay valid while the JIT's code runs;
+//           gpr points to the general purpose registers,
+//           hilo to the 8 bytes of the HI and LO registers (LO first),
+//           memory to the VM's memory, and pc to the PC
+// Return a JIT for a program with text_words words of text,
+// or NULL if the JIT cannot run on this host
+jit_t *jit_create(word_type *gpr, word_type *hilo, byte_type *memory,
+		  address_type *pc, unsigned int text_words)
+{
+    jit_t *j = (jit_t *)malloc(sizeof(jit_t));
+    if (j == NULL) {
+	bail_with_error("Cannot allocate a JIT!");
+    }
+    void *p = mmap(NULL, CODE_BUFFER_BYTES, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+	free(j);
+	return NULL;
+    }
+    j->code_buffer = (byte_type *)p;
+    j->code_used = 0;
+    j->page_size = (size_t)sysconf(_SC_PAGESIZE);
+    j->vm_gpr = gpr;
+    j->vm_hilo = hilo;
+    j->vm_memory = memory;
+    j->vm_pc = pc;
+    j->vm_text_bytes = text_words * BYTES_PER_WORD;
+    return j;
+}
+
+// Free j and all of the code it made
+void jit_destroy(jit_t *j)
+{
+    munmap(j->code_buffer, CODE_BUFFER_BYTES);
+    free(j);
+}
+
+// Forget all of the code j made, so its buffer can be reused
+// (the blocks it was made for must no longer use it)
+void jit_flush(jit_t *j)
+{
+    j->code_used = 0;
+}
+
+// Give the pages of j's buffer that hold any of the bytes
+// from offset from up to offset to the protection prot;
+// return true if that worked
+static bool protect(jit_t *j, size_t from, size_t to, int prot)
+{
+    size_t first = from - from % j->page_size;
+    size_t last = to + (j->page_size - 1);
+    last -= last % j->page_size;
+    if (last > CODE_BUFFER_BYTES) {
+	last = CODE_BUFFER_BYTES;
+    }
+    return first >= last
+	|| mprotect(j->code_buffer + first, last - first, prot) == 0;
+}
+
+// Emit the byte b for j
+static void emit(jit_t *j, byte_type b)
+{
+    *j->code_next++ = b;
+}
+
+// Emit the bytes given, of which there are n
+static void emit_bytes(jit_t *j, const byte_type *bs, int n)
+{
+    for (int i = 0; i < n; i++) {
+	emit(j, bs[i]);
+    }
+}
+
+// Emit the 32 bit value v (little-endian)
+static void emit_imm32(jit_t *j, uint32_t v)
+{
+    for (int i = 0; i < 4; i++) {
+	emit(j, (v >> (8 * i)) & 0xff);
+    }
+}
+
+// Emit the 64 bit value v (little-endian)
+static void emit_imm64(jit_t *j, uint64_t v)
+{
+    emit_imm32(j, (uint32_t)v);
+    emit_imm32(j, (uint32_t)(v >> 32));
+}
+
+// the host registers used, as numbered in x86 instructions
+#define EAX 0
+#define ECX 1
+#define EDX 2
+
+// Emit an instruction with the given opcode byte whose operands are
+// the host register hr and the SRM register r (in memory at rbx + 4*r)
+static void emit_gpr_op(jit_t *j, byte_type opcode, int hr, reg_num_type r)
+{
+    emit(j, opcode);
+    emit(j, 0x43 | (hr << 3)); // [rbx + disp8]
+    emit(j, r * BYTES_PER_WORD);
+}
+
+// Emit code to load the SRM register r into the host register hr
+static void emit_load_gpr(jit_t *j, int hr, reg_num_type r)
+{
+    emit_gpr_op(j, 0x8B, hr, r);
+}
+
+// Emit code to store the host register hr into the SRM register r
+static void emit_store_gpr(jit_t *j, int hr, reg_num_type r)
+{
+    emit_gpr_op(j, 0x89, hr, r);
+}
+
+// Emit code to set the PC to the constant addr
+static void emit_set_pc(jit_t *j, address_type addr)
+{
+    static const byte_type mov_r14_imm[] = { 0x41, 0xC7, 0x06 };
+    emit_bytes(j, mov_r14_imm, sizeof(mov_r14_imm));
+    emit_imm32(j, addr);
+}
+
+// the number of bytes emitted by emit_return
+#define RETURN_BYTES 13
+
+// Emit code to return the word address wa from the native code
+static void emit_return(jit_t *j, unsigned int wa)
+{
+    static const byte_type epilogue[] = {
+	0x41, 0x5E, // pop r14
+	0x41, 0x5D, // pop r13
+	0x41, 0x5C, // pop r12
+	0x5B,       // pop rbx
+	0xC3        // ret
+    };
+    emit(j, 0xB8); // mov eax, imm32
+    emit_imm32(j, wa);
+    emit_bytes(j, epilogue, sizeof(epilogue));
+}
+
+// Emit code that returns the word address wa from the native code
+// if the unsigned value in eax is less than bound
+static void emit_return_if_below(jit_t *j, uint32_t bound, unsigned int wa)
+{
+    emit(j, 0x3D); // cmp eax, imm32
+    emit_imm32(j, bound);
+    emit(j, 0x73); // jae over the return
+    emit(j, RETURN_BYTES);
+    emit_return(j, wa);
+}
+
+// Emit code to put the byte address GPR[di->rs] + di->immed in eax
+static void emit_effective_address(jit_t *j, const decoded_instr_t *di)
+{
+    emit_load_gpr(j, EAX, di->rs);
+    emit(j, 0x05); // add eax, imm32
+    emit_imm32(j, di->immed);
+}
+
+// Emit code to put the address of a word, GPR[di->rs] + di->immed
+// rounded down to a multiple of BYTES_PER_WORD, in eax
+static void emit_word_address(jit_t *j, const decoded_instr_t *di)
+{
+    static const byte_type and_eax_not3[] = { 0x83, 0xE0, 0xFC };
+    emit_effective_address(j, di);
+    emit_bytes(j, and_eax_not3, sizeof(and_eax_not3));
+}
+
+// Emit code for a conditional branch, which is taken unless
+// the flags satisfy the condition of the jcc opcode skip_if
+static void emit_branch(jit_t *j, byte_type skip_if, address_type target)
+{
+    emit(j, skip_if);
+    emit(j, 7); // the length of the code from emit_set_pc
+    emit_set_pc(j, target);
+}
+
+// Emit code for di, which is at word address wa
+// (and ends its block when it is a branch or jump);
+// return false (emitting nothing) if there is no code for di
+static bool emit_instr(jit_t *j, const decoded_instr_t *di, unsigned int wa)
+{
+    switch (di->handler) {
+    case ADD_H: case SUB_H: case AND_H: case BOR_H: case XOR_H: case NOR_H:
+	{
+	    byte_type opcode = 0;
+	    switch (di->handler) {
+	    case ADD_H: opcode = 0x03; break;
+	    case SUB_H: opcode = 0x2B; break;
+	    case AND_H: opcode = 0x23; break;
+	    case XOR_H: opcode = 0x33; break;
+	    default: opcode = 0x0B; break; // BOR_H and NOR_H
+	    }
+	    emit_load_gpr(j, EAX, di->rs);
+	    emit_gpr_op(j, opcode, EAX, di->rt);
+	    if (di->handler == NOR_H) {
+		emit(j, 0xF7); // not eax
+		emit(j, 0xD0);
+	    }
+	    emit_store_gpr(j, EAX, di->rd);
+	}
+	break;
+    case MUL_H:
+	{
+	    // the product is an int, sign extended to fill HI and LO
+	    static const byte_type sign_extend_store[] = {
+		0x48, 0x63, 0xC0,      // movsxd rax, eax
+		0x49, 0x89, 0x45, 0x00 // mov [r13], rax
+	    };
+	    emit_load_gpr(j, EAX, di->rs);
+	    emit(j, 0x0F); // imul eax, [rbx + disp8]
+	    emit_gpr_op(j, 0xAF, EAX, di->rt);
+	    emit_bytes(j, sign_extend_store, sizeof(sign_extend_store));
+	}
+	break;
+    case DIV_H:
+	{
+	    static const byte_type divide_store[] = {
+		0x99,                   // cdq
+		0xF7, 0xF9,             // idiv ecx
+		0x41, 0x89, 0x45, 0x00, // mov [r13], eax (LO)
+		0x41, 0x89, 0x55, 0x04  // mov [r13 + 4], edx (HI)
+	    };
+	    emit_load_gpr(j, ECX, di->rt);
+	    emit(j, 0x89); // mov eax, ecx
+	    emit(j, 0xC8);
+	    // let the interpreter report a division by zero
+	    emit_return_if_below(j, 1, wa);
+	    emit_load_gpr(j, EAX, di->rs);
+	    emit_bytes(j, divide_store, sizeof(divide_store));
+	}
+	break;
+    case MFHI_H: case MFLO_H:
+	emit(j, 0x41); // mov eax, [r13 + disp8]
+	emit(j, 0x8B);
+	emit(j, 0x45);
+	emit(j, di->handler == MFHI_H ? BYTES_PER_WORD : 0);
+	emit_store_gpr(j, EAX, di->rd);
+	break;
+    case SLL_H: case SRL_H:
+	emit_load_gpr(j, EAX, di->rt);
+	emit(j, 0xC1); // shl/shr eax, imm8
+	emit(j, di->handler == SLL_H ? 0xE0 : 0xE8);
+	emit(j, di->shift);
+	emit_store_gpr(j, EAX, di->rd);
+	break;
+    case ADDI_H: case ANDI_H: case BORI_H: case XORI_H:
+	emit_load_gpr(j, EAX, di->rs);
+	switch (di->handler) {
+	case ADDI_H: emit(j, 0x05); break;
+	case ANDI_H: emit(j, 0x25); break;
+	case BORI_H: emit(j, 0x0D); break;
+	default: emit(j, 0x35); break;
+	}
+	emit_imm32(j, di->immed);
+	emit_store_gpr(j, EAX, di->rt);
+	break;
+    case LW_H:
+	{
+	    static const byte_type load_word[] = {
+		0x41, 0x8B, 0x04, 0x04 // mov eax, [r12 + rax]
+	    };
+	    emit_word_address(j, di);
+	    emit_bytes(j, load_word, sizeof(load_word));
+	    emit_store_gpr(j, EAX, di->rt);
+	}
+	break;
+    case LBU_H:
+	{
+	    static const byte_type load_byte[] = {
+		0x41, 0x0F, 0xB6, 0x04, 0x04 // movzx eax, byte [r12 + rax]
+	    };
+	    emit_effective_address(j, di);
+	    emit_bytes(j, load_byte, sizeof(load_byte));
+	    emit_store_gpr(j, EAX, di->rt);
+	}
+	break;
+    case SW_H: case SB_H:
+	{
+	    static const byte_type store_word[] = {
+		0x41, 0x89, 0x0C, 0x04 // mov [r12 + rax], ecx
+	    };
+	    static const byte_type store_byte[] = {
+		0x41, 0x88, 0x0C, 0x04 // mov [r12 + rax], cl
+	    };
+	    if (di->handler == SW_H) {
+		emit_word_address(j, di);
+	    } else {
+		emit_effective_address(j, di);
+	    }
+	    // let the interpreter store into the text (and re-decode it)
+	    emit_return_if_below(j, j->vm_text_bytes, wa);
+	    emit_load_gpr(j, ECX, di->rt);
+	    if (di->handler == SW_H) {
+		emit_bytes(j, store_word, sizeof(store_word));
+	    } else {
+		emit_bytes(j, store_byte, sizeof(store_byte));
+	    }
+	}
+	break;
+    case BEQ_H: case BNE_H:
+	emit_load_gpr(j, EAX, di->rs);
+	emit_gpr_op(j, 0x3B, EAX, di->rt); // cmp eax, [rbx + disp8]
+	emit_branch(j, di->handler == BEQ_H ? 0x75 : 0x74, di->target);
+	break;
+    case BGEZ_H: case BGTZ_H: case BLEZ_H: case BLTZ_H:
+	{
+	    byte_type skip_if = 0;
+	    switch (di->handler) {
+	    case BGEZ_H: skip_if = 0x7C; break; // jl
+	    case BGTZ_H: skip_if = 0x7E; break; // jle
+	    case BLEZ_H: skip_if = 0x7F; break; // jg
+	    default: skip_if = 0x7D; break;     // jge
+	    }
+	    emit_gpr_op(j, 0x83, 7, di->rs); // cmp dword [rbx + disp8], imm8
+	    emit(j, 0);
+	    emit_branch(j, skip_if, di->target);
+	}
+	break;
+    case JMP_H:
+	emit_set_pc(j, di->target);
+	break;
+    case JAL_H:
+	emit_gpr_op(j, 0xC7, 0, RA); // mov dword [rbx + disp8], imm32
+	emit_imm32(j, (wa + 1) * BYTES_PER_WORD);
+	emit_set_pc(j, di->target);
+	break;
+    case JR_H:
+	emit_load_gpr(j, EAX, di->rs);
+	emit(j, 0x41); // mov [r14], eax
+	emit(j, 0x89);
+	emit(j, 0x06);
+	break;
+    default:
+	// system calls and invalid instructions are left to the interpreter
+	return false;
+	break;
+    }
+    return true;
+}
+
+// Requires: instrs holds the program's text
+// Set b->native to native code for the instructions in b,
+// made by j, up to the first system call or invalid instruction in b
+// (or leave it NULL if the code would be empty, there is no room,
+// or the buffer's protection cannot be changed).
+// The code returns the word address of the first instruction
+// it did not execute, which is b->end if it executed them all;
+// it stops early, before a store into the text or a division by zero,
+// so that the interpreter can execute that instruction.
+// It does not count instructions or check the VM's invariant.
+void jit_compile_block(jit_t *j, block_t *b, const bin_instr_t *instrs)
+{
+    static const byte_type prologue[] = {
+	0x53,       // push rbx
+	0x41, 0x54, // push r12
+	0x41, 0x55, // push r13
+	0x41, 0x56  // push r14
+    };
+    size_t room = (b->end - b->first) * MAX_INSTR_BYTES + MAX_FRAME_BYTES;
+    if (j->code_used + room > CODE_BUFFER_BYTES) {
+	return;
+    }
+    // the page where the code starts may hold the end of the code
+    // of another block, which is not executed while this is compiled
+    if (!protect(j, j->code_used, j->code_used + room,
+		 PROT_READ | PROT_WRITE)) {
+	return;
+    }
+    byte_type *start = j->code_buffer + j->code_used;
+    j->code_next = start;
+    emit_bytes(j, prologue, sizeof(prologue));
+    emit(j, 0x48); emit(j, 0xBB); emit_imm64(j, (uintptr_t)j->vm_gpr);
+    emit(j, 0x49); emit(j, 0xBC); emit_imm64(j, (uintptr_t)j->vm_memory);
+    emit(j, 0x49); emit(j, 0xBD); emit_imm64(j, (uintptr_t)j->vm_hilo);
+    emit(j, 0x49); emit(j, 0xBE); emit_imm64(j, (uintptr_t)j->vm_pc);
+    unsigned int wa = b->first;
+    while (wa < b->end) {
+	decoded_instr_t di = decode_instr(instrs[wa], wa * BYTES_PER_WORD);
+	if (!emit_instr(j, &di, wa)) {
+	    break;
+	}
+	wa++;
+    }
+    if (wa == b->first) {
+	j->code_next = start; // nothing to compile
+    } else {
+	emit_return(j, wa);
+    }
+    if (!protect(j, j->code_used, j->code_next - j->code_buffer,
+		 PROT_READ | PROT_EXEC) || j->code_next == start) {
+	return;
+    }
+    j->code_used += j->code_next - start;
+    b->native = (native_code_t)start;
+}
+
+#else
+
+// Requires: all of the pointers stay valid while the JIT's code runs;
+//           gpr points to the general purpose registers,
+//           hilo to the 8 bytes of the HI and LO registers (LO first),
+//           memory to the VM's memory, and pc to the PC
+// Return NULL, as the JIT only generates x86-64 code for Linux
+jit_t *jit_create(word_type *gpr, word_type *hilo, byte_type *memory,
+		  address_type *pc, unsigned int text_words)
+{
+    return NULL;
+}
+
+// Do nothing, as jit_create never returns a JIT on this host
+void jit_destroy(jit_t *j)
+{
+}
+
+// Do nothing, as jit_create never returns a JIT on this host
+void jit_flush(jit_t *j)
+{
+}
+
+// Requires: instrs holds the program's text
+// Leave b->native NULL, as the JIT is not available on this host
+void jit_compile_block(jit_t *j, block_t *b, const bin_instr_t *instrs)
+{
+}
+
+#endif
@@ -0,0 +1,48 @@
+/* $Id$ */
+// A just-in-time compiler from the VM's basic blocks to x86-64 code
+#ifndef _JIT_H
+#define _JIT_H
+#include <stdbool.h>
+#include "machine_types.h"
+#include "instruction.h"
+#include "blocks.h"
+
+// the number of times a block is interpreted before it is compiled
+#define JIT_HOT_COUNT 16
+
+// a JIT for one machine's program, with its own buffer of code
+typedef struct jit_s jit_t;
+
+// Requires: all of the pointers stay valid while the JIT's code runs;
+//           gpr points to the general purpose registers,
+//           hilo to the 8 bytes of the HI and LO registers (LO first),
+//           memory to the VM's memory, and pc to the PC
+// Return a JIT for a program with text_words words of text,
+// or NULL if the JIT cannot run on this host
+extern jit_t *jit_create(word_type *gpr, word_type *hilo,
+			 byte_type *memory, address_type *pc,
+			 unsigned int text_words);
+
+// Free j and all of the code it made
+extern void jit_destroy(jit_t *j);
+
+// Forget all of the code j made, so its buffer can be reused
+// (the blocks it was made for must no longer use it)
+extern void jit_flush(jit_t *j);
+
+// Requires: instrs holds the program's text
+// Set b->native to native code for the instructions in b,
+// made by j, up to the first system call or invalid instruction in b
+// (or leave it NULL if the code would be empty, there is no room,
+// or the buffer's protection cannot be changed).
+// The buffer is only writable while code is being written into it,
+// and only executable once it has been.
+// The code returns the word address of the first instruction
+// it did not execute, which is b->end if it executed them all;
+// it stops early, before a store into the text or a division by zero,
+// so that the interpreter can execute that instruction.
+// It does not count instructions or check the VM's invariant.
+extern void jit_compile_block(jit_t *j, block_t *b,
+			      const bin_instr_t *instrs);
+
+#endif
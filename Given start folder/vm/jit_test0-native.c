@@ -0,0 +1,221 @@
+/* Generated by bof2c from jit_test0.bof; do not edit */
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MEMORY_SIZE_IN_BYTES 65532
+#define MEMORY_SIZE_IN_WORDS 16383
+
+// the SRM's memory, holding the program's text and data
+static union {
+    unsigned char bytes[MEMORY_SIZE_IN_BYTES];
+    int words[MEMORY_SIZE_IN_WORDS];
+} memory = { .words = {
+    [0] = 2637833,
+    [1] = 32777,
+    [2] = -200887,
+    [3] = 18283,
+    [4] = 20323,
+    [5] = 323401,
+    [6] = 1677740608,
+    [7] = 1208614912,
+    [8] = 1074462720,
+    [9] = -2079304704,
+    [10] = -1945084928,
+    [11] = 483337,
+    [12] = 1811964544,
+    [13] = 1074593792,
+    [14] = 1208877056,
+    [15] = -1743754240,
+    [16] = -1810926592,
+    [17] = -1878043712,
+    [18] = -1676704832,
+    [19] = 7305216,
+    [20] = 206534656,
+    [21] = -2079294464,
+    [22] = 2147451916,
+    [23] = 16811021,
+    [24] = 5604366,
+    [25] = 83752,
+    [26] = 116516,
+    [27] = -2079276032,
+    [28] = 51235,
+    [29] = 51243,
+    [30] = 68097,
+    [31] = 32777,
+    [32] = 66056,
+    [33] = 99337,
+    [34] = 66054,
+    [35] = 164873,
+    [36] = 84484,
+    [37] = 32777,
+    [38] = 84485,
+    [39] = 230409,
+    [40] = 3011,
+    [41] = -48631,
+    [42] = -2686457,
+    [43] = 2882,
+    [44] = 32777,
+    [45] = 1811940352,
+    [46] = 805307008,
+    [47] = -2080079872,
+    [48] = 805306688,
+    [49] = 663561,
+    [50] = 805307072,
+    [51] = 536872896,
+} };
+
+// Print msg and a newline on stderr, as the VM does, and exit with a failure code
+static void bail(const char *msg)
+{
+    fflush(stdout);
+    fprintf(stderr, "%s\n", msg);
+    exit(EXIT_FAILURE);
+}
+
+int main()
+{
+    int r0 = 0; // $0
+    int r4 = 4096; // $a0
+    int r8 = 0; // $t0
+    int r9 = 0; // $t1
+    int r10 = 0; // $t2
+    int r11 = 0; // $t3
+    int r12 = 0; // $t4
+    int r13 = 0; // $t5
+    int r14 = 0; // $t6
+    int r15 = 0; // $t7
+    int r16 = 0; // $s0
+    int r24 = 0; // $t8
+    int r25 = 0; // $t9
+    int r28 = 1024; // $gp
+    int r29 = 4096; // $sp
+    int r31 = 0; // $ra
+    int hi = 0;
+    int lo = 0;
+    unsigned int pc;
+
+    pc = 0;
+    goto dispatch;
+ a0:	// ADDI $0, $t0, 40
+	r8 = (int)((unsigned)r0 + (unsigned)40);
+	// ADDI $0, $s0, 0
+	r16 = (int)((unsigned)r0 + (unsigned)0);
+ a8:	// ADDI $sp, $sp, -4
+	r29 = (int)((unsigned)r29 + (unsigned)-4);
+	// SW $sp, $t0, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r29 + 0) / 4)] = r8;
+	// LW $sp, $t1, 0	# offset is +0 bytes
+	r9 = memory.words[(unsigned)((r29 + 0) / 4)];
+	// ADDI $sp, $sp, 4
+	r29 = (int)((unsigned)r29 + (unsigned)4);
+	// MUL $t1, $t1
+	lo = (int)((unsigned)r9 * (unsigned)r9); hi = ((int)((unsigned)r9 * (unsigned)r9) < 0) ? -1 : 0;
+	// MFLO $t2
+	r10 = lo;
+	// MFHI $t3
+	r11 = hi;
+	// ADD $s0, $t2, $s0
+	r16 = (int)((unsigned)r16 + (unsigned)r10);
+	// SUB $s0, $t3, $s0
+	r16 = (int)((unsigned)r16 - (unsigned)r11);
+	// ADDI $0, $t4, 7
+	r12 = (int)((unsigned)r0 + (unsigned)7);
+	// DIV $t2, $t4
+	if (r12 == 0) { bail("Attempt to divide by zero!"); } hi = r10 % r12; lo = r10 / r12;
+	// MFHI $t5
+	r13 = hi;
+	// MFLO $t6
+	r14 = lo;
+	// XOR $s0, $t5, $s0
+	r16 = r16 ^ r13;
+	// BOR $s0, $t6, $t7
+	r15 = r16 | r14;
+	// AND $t7, $t2, $t7
+	r15 = r15 & r10;
+	// NOR $t7, $s0, $t7
+	r15 = ~(r15 | r16);
+	// SLL $t7, $t7, 3
+	r15 = (int)((unsigned)r15 << 3);
+	// SRL $t7, $t7, 2
+	r15 = (int)((unsigned)r15 >> 2);
+	// ADD $s0, $t7, $s0
+	r16 = (int)((unsigned)r16 + (unsigned)r15);
+	// ANDI $s0, $s0, 0x7fff
+	r16 = r16 & 32767;
+	// BOI $s0, $s0, 0x100
+	r16 = r16 | 256;
+	// XORI $s0, $s0, 0x55
+	r16 = r16 ^ 85;
+	// SB $gp, $t0, 1	# offset is +4 bytes
+	memory.bytes[(unsigned)(r28 + 4)] = r8;
+	// LBU $gp, $t8, 1	# offset is +4 bytes
+	r24 = memory.bytes[(unsigned)(r28 + 4)];
+	// ADD $s0, $t8, $s0
+	r16 = (int)((unsigned)r16 + (unsigned)r24);
+	// LW $0, $t9, 0	# offset is +0 bytes
+	r25 = memory.words[(unsigned)((r0 + 0) / 4)];
+	// SW $0, $t9, 0	# offset is +0 bytes
+	memory.words[(unsigned)((r0 + 0) / 4)] = r25;
+	// BGEZ $t0, 1	# offset is +4 bytes
+	if (r8 >= 0) goto a128;
+	// ADDI $0, $s0, 0
+	r16 = (int)((unsigned)r0 + (unsigned)0);
+ a128:	// BLTZ $t0, 1	# offset is +4 bytes
+	if (r8 < 0) goto a136;
+	// ADDI $s0, $s0, 1
+	r16 = (int)((unsigned)r16 + (unsigned)1);
+ a136:	// BLEZ $t0, 1	# offset is +4 bytes
+	if (r8 <= 0) goto a144;
+	// ADDI $s0, $s0, 2
+	r16 = (int)((unsigned)r16 + (unsigned)2);
+ a144:	// BEQ $t0, $t1, 1	# offset is +4 bytes
+	if (r8 == r9) goto a152;
+	// ADDI $0, $s0, 0
+	r16 = (int)((unsigned)r0 + (unsigned)0);
+ a152:	// BNE $t0, $t1, 1	# offset is +4 bytes
+	if (r8 != r9) goto a160;
+	// ADDI $s0, $s0, 3
+	r16 = (int)((unsigned)r16 + (unsigned)3);
+ a160:	// JAL 47	# target is byte address 188
+	r31 = 164; goto a188;
+ a164:	// ADDI $t0, $t0, -1
+	r8 = (int)((unsigned)r8 + (unsigned)-1);
+	// BGTZ $t0, -41	# offset is -164 bytes
+	if (r8 > 0) goto a8;
+	// JMP 45	# target is byte address 180
+	goto a180;
+	// ADDI $0, $s0, 0
+	r16 = (int)((unsigned)r0 + (unsigned)0);
+ a180:	// DIV $s0, $0
+	if (r0 == 0) { bail("Attempt to divide by zero!"); } hi = r16 % r0; lo = r16 / r0;
+	// EXIT 
+	exit(0);
+ a188:	// ADD $0, $s0, $a0
+	r4 = (int)((unsigned)r0 + (unsigned)r16);
+	// PINT 
+	printf("%d", r4);
+	// ADDI $0, $a0, 10
+	r4 = (int)((unsigned)r0 + (unsigned)10);
+	// PCH 
+	fputc(r4, stdout);
+	// JR $ra
+	pc = r31; goto dispatch;
+	pc = 208;
+ dispatch:
+    switch (pc) {
+    case 0: goto a0;
+    case 8: goto a8;
+    case 128: goto a128;
+    case 136: goto a136;
+    case 144: goto a144;
+    case 152: goto a152;
+    case 160: goto a160;
+    case 164: goto a164;
+    case 180: goto a180;
+    case 188: goto a188;
+    default:
+	fprintf(stderr, "bof2c: no code for address %u\n", pc);
+	bail("(only addresses of labels can be jumped to)");
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+	# $Id$
+	# a hot loop using each instruction the JIT compiles,
+	# for comparing the VM's output with and without -j
+	.text start
+start:	ADDI $0, $t0, 40     # $t0 counts down the iterations
+	ADDI $0, $s0, 0      # $s0 accumulates a checksum
+loop:	ADDI $sp, $sp, -4    # push $t0
+	SW $sp, $t0, 0
+	LW $sp, $t1, 0       # pop it into $t1
+	ADDI $sp, $sp, 4
+	MUL $t1, $t1
+	MFLO $t2             # $t2 is $t0 * $t0
+	MFHI $t3             # $t3 is 0
+	ADD $s0, $t2, $s0
+	SUB $s0, $t3, $s0
+	ADDI $0, $t4, 7
+	DIV $t2, $t4
+	MFHI $t5             # $t5 is $t2 % 7
+	MFLO $t6             # $t6 is $t2 / 7
+	XOR $s0, $t5, $s0
+	BOR $s0, $t6, $t7
+	AND $t7, $t2, $t7
+	NOR $t7, $s0, $t7
+	SLL $t7, $t7, 3
+	SRL $t7, $t7, 2
+	ADD $s0, $t7, $s0
+	ANDI $s0, $s0, 0x7fff
+	BORI $s0, $s0, 0x100
+	XORI $s0, $s0, 0x55
+	SB $gp, $t0, 1       # store $t0's low byte in the second word
+	LBU $gp, $t8, 1
+	ADD $s0, $t8, $s0
+	LW $0, $t9, 0        # store the first instruction
+	SW $0, $t9, 0        # back into the text
+	BGEZ $t0, 1          # always taken
+	ADDI $0, $s0, 0
+	BLTZ $t0, 1          # never taken
+	ADDI $s0, $s0, 1
+	BLEZ $t0, 1          # never taken
+	ADDI $s0, $s0, 2
+	BEQ $t0, $t1, 1      # always taken
+	ADDI $0, $s0, 0
+	BNE $t0, $t1, 1      # never taken
+	ADDI $s0, $s0, 3
+	JAL print
+	ADDI $t0, $t0, -1
+	BGTZ $t0, -41        # back to loop while $t0 > 0
+	JMP done
+	ADDI $0, $s0, 0
+done:	DIV $s0, $0          # the division by zero ends the program
+	EXIT
+print:	ADD $0, $s0, $a0     # print $s0 and a newline
+	PINT
+	ADDI $0, $a0, 10
+	PCH
+	JR $ra
+	.data 1024
+	WORD first = 0
+	WORD second = 0
+	.stack 4096
+	.end
@@ -0,0 +1,15 @@
+	# $Id$
+	# a program that never stops, for testing the VM's limits
+	# (--max-instrs and --max-ms)
+	.text start
+start:	ADDI $0, $a0, 42     # print a star first
+	PCH
+	ADDI $0, $t0, 0      # $t0 counts the iterations
+loop:	ADDI $t0, $t0, 1
+	SW $gp, $t0, 0
+	BEQ $0, $0, -3       # back to loop, forever
+	EXIT
+	.data 1024
+	WORD count = 0
+	.stack 4096
+	.end
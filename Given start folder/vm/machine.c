@@ -1,551 +1,1457 @@
 /* $Id: machine.c,v 1.19 2023/11/14 18:29:49 leavens Exp leavens $ */
+// (for program_invocation_short_name, used to report invariant failures)
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
 #include <assert.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "machine_types.h"
 #include "machine.h"
 #include "regname.h"
+#include "decode.h"
+#include "blocks.h"
+#include "jit.h"
+#include "profile.h"
+#include "analysis.h"
+#include "trace.h"
 #include "utilities.h"
 
-#define MAX_PRINT_WIDTH 59
-
-// the VM's memory, both in byte, word, and binary instruction views.
-static union mem_u {
-    byte_type bytes[MEMORY_SIZE_IN_BYTES];
-    word_type words[MEMORY_SIZE_IN_WORDS];
-    bin_instr_t instrs[MEMORY_SIZE_IN_WORDS];
-} memory;
-
-// general purpose registers
-static word_type GPR[NUM_REGISTERS];
-// hi and lo registers used in multiplication and division,
-// and a view as a long
-static union longAs2words_u {
-    unsigned long result;
-    word_type hilo[2]; // lo is index 0, hi is index 1
-                       // because the x86 is little-endian
-} hilo_regs;
+// Use direct-threaded dispatch (labels as values) when the compiler
+// supports it, unless the portable switch engine is asked for
+// by defining VM_SWITCH_DISPATCH
+#if defined(__GNUC__) && !defined(VM_SWITCH_DISPATCH)
+#define VM_THREADED_DISPATCH
+#endif
 
 #define LO 0
 #define HI 1
 
-// the program counter
-static address_type PC;
+// the size of each machine's buffer for its program's output
+#define OUTPUT_BUFFER_SIZE 65536
 
-// should the machine be printing tracing output?
-static bool tracing;
+// the magic number that starts a snapshot file
+#define SNAPSHOT_MAGIC "SRMS"
+// the size of the pages of memory in a snapshot
+#define SNAPSHOT_PAGE_SIZE 4096
+#define SNAPSHOT_PAGES \
+    ((MEMORY_SIZE_IN_BYTES + SNAPSHOT_PAGE_SIZE - 1) / SNAPSHOT_PAGE_SIZE)
 
-// words of instructions loaded (based on the header)
-static unsigned int instructions_loaded;
-// words of global data (based on the header)
-static unsigned int global_data_words;
+// how many instructions a machine with a time limit runs
+// between looking at the clock
+#define TIME_CHECK_INTERVAL (1UL << 18)
 
-// the bottom of the stack from the BOF file, for tracing purposes
-static unsigned int stack_bottom_address;
+// the state of a virtual machine
+// (a machine is allocated with mmap, so its memory, which comes first,
+// starts on a page boundary, and the OS only zeroes each of its pages
+// when the page is first touched)
+struct machine_s {
+    // the VM's memory, both in byte, word, and binary instruction views.
+    union mem_u {
+	byte_type bytes[MEMORY_SIZE_IN_BYTES];
+	word_type words[MEMORY_SIZE_IN_WORDS];
+	bin_instr_t instrs[MEMORY_SIZE_IN_WORDS];
+    } memory;
 
-// should the machine be running? (default true)
-static bool running;
+    // output written by the program's system calls but not yet
+    // passed on to out, and the number of bytes of it
+    char output[OUTPUT_BUFFER_SIZE];
+    size_t output_used;
 
-// set up the state of the machine
-static void initialize()
+    // general purpose registers
+    word_type GPR[NUM_REGISTERS];
+    // hi and lo registers used in multiplication and division,
+    // and a view as a long
+    union longAs2words_u {
+	unsigned long result;
+	word_type hilo[2]; // lo is index 0, hi is index 1
+			   // because the x86 is little-endian
+    } hilo_regs;
+
+    // the program counter
+    address_type PC;
+
+    // should the machine be printing tracing output?
+    bool tracing;
+
+    // the file that tracing output is written to in binary form
+    // (see trace.h), along with the program's output and error messages,
+    // or NULL if tracing output is printed as text on out
+    FILE *trace;
+    // the registers as of the last state written to trace,
+    // and has what happened since the last state traced been followed
+    // (in trace or in trace_cache)? (if not, the next state is
+    // written in full, or the cache is emptied first)
+    word_type traced_GPR[NUM_REGISTERS];
+    word_type traced_hilo[2];
+    bool trace_synced;
+    // the text printed for states when tracing as text, kept between
+    // states (or NULL if nothing has been traced), which is kept up to date
+    // with the stores made while tracing (when trace_synced is true)
+    trace_cache_t *trace_cache;
+
+    // the header of the loaded program's BOF file
+    BOFHeader header;
+    // words of instructions loaded (based on the header)
+    unsigned int instructions_loaded;
+    // the loaded instructions in pre-decoded form,
+    // kept consistent with memory by stores into the text section
+    decoded_instr_t *decoded;
+    // which of the loaded instructions start basic blocks
+    bool *leaders;
+    // words of global data (based on the header)
+    unsigned int global_data_words;
+
+    // the bottom of the stack from the BOF file, for tracing purposes
+    unsigned int stack_bottom_address;
+
+    // has a program been loaded (and maybe run) since memory was zeroed?
+    bool memory_used;
+
+    // should the machine be running? (default true)
+    bool running;
+    // the exit status, once the machine has stopped
+    int exit_status;
+
+    // number of instructions executed since the program was loaded
+    unsigned long instructions_executed;
+
+    // the most instructions the program may execute, and the most
+    // milliseconds it may run for (0 for no limit), when it started
+    // running, and the instruction count at which the engines next
+    // check these limits (at branches and jumps, or between blocks)
+    unsigned long max_instrs;
+    unsigned long max_ms;
+    struct timespec run_start;
+    unsigned long limit_check_at;
+
+    // the handler labels of the threaded dispatch engine, once it is running
+    const void **threaded_labels;
+
+    // how often the invariant is checked (default: before every instruction)
+    check_mode_type check_mode;
+
+    // does decoded hold superinstructions? (only in release_checking mode,
+    // since a superinstruction skips the checks between its instructions)
+    bool fusing;
+
+    // should the program be run a basic block at a time? (default false)
+    bool using_blocks;
+
+    // should hot blocks be compiled to native code? (default false)
+    bool using_jit;
+
+    // the basic blocks of the program, when running a block at a time,
+    // and the JIT that compiles them, when using it (otherwise NULL)
+    block_cache_t *blocks;
+    jit_t *jit;
+
+    // the block the block engine is running (NULL between blocks),
+    // the word address of its next instruction to execute,
+    // and the word address at which it stops running that block
+    // (which a store into the text changes)
+    block_t *block_running;
+    unsigned int block_next;
+    unsigned int block_stop;
+
+    // should the program be run by the profiling engine? (default false)
+    bool profiling;
+    // the counts gathered by the profiling engine (otherwise NULL)
+    profile_t *profile;
+    // should the profiling engine also feed the program's memory accesses
+    // and branches to simulated models of a cache and a branch predictor,
+    // of the given shapes? (default false)
+    bool analyzing;
+    cache_config_t cache_config;
+    predictor_config_t predictor_config;
+    // the models and their counts, when analyzing (otherwise NULL)
+    analysis_t *analysis;
+
+    // where the program's input comes from, where its output
+    // (and tracing output) goes, and where error messages go
+    FILE *in;
+    FILE *out;
+    FILE *err;
+};
+
+// Advance m's PC and instruction count past all but the first
+// of the instructions that the pre-decoded instruction di stands for
+#define ADVANCE_PAST_FUSED(di)						\
+    do {								\
+	m->PC = m->PC + ((di)->length - 1) * BYTES_PER_WORD;		\
+	m->instructions_executed += (di)->length - 1;			\
+    } while (0)
+
+static void execute_decoded(machine_t *m, const decoded_instr_t *di);
+static void note_store(machine_t *m, address_type wa);
+static void output_flush(machine_t *m);
+
+// Return a new machine, with nothing loaded,
+// which reads from stdin and writes on stdout and stderr
+machine_t *machine_create()
+{
+    void *p = mmap(NULL, sizeof(machine_t), PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+	bail_with_error("Cannot allocate a machine!");
+    }
+    machine_t *m = (machine_t *)p;
+    m->memory_used = false;
+    m->check_mode = paranoid_checking;
+    m->using_blocks = false;
+    m->using_jit = false;
+    m->decoded = NULL;
+    m->leaders = NULL;
+    m->blocks = NULL;
+    m->jit = NULL;
+    m->threaded_labels = NULL;
+    m->block_running = NULL;
+    m->profiling = false;
+    m->profile = NULL;
+    m->analyzing = false;
+    m->analysis = NULL;
+    m->max_instrs = 0;
+    m->max_ms = 0;
+    m->trace = NULL;
+    m->trace_cache = NULL;
+    m->running = false;
+    m->exit_status = EXIT_SUCCESS;
+    m->in = stdin;
+    m->out = stdout;
+    m->err = stderr;
+    return m;
+}
+
+// Free the blocks of m's program and the JIT's code for them, if any
+static void free_blocks(machine_t *m)
+{
+    if (m->blocks != NULL) {
+	blocks_destroy(m->blocks);
+	m->blocks = NULL;
+    }
+    if (m->jit != NULL) {
+	jit_destroy(m->jit);
+	m->jit = NULL;
+    }
+    m->block_running = NULL;
+}
+
+// Free the profile of m's program, if any
+static void free_profile(machine_t *m)
+{
+    if (m->profile != NULL) {
+	profile_destroy(m->profile);
+	m->profile = NULL;
+    }
+}
+
+// Return the profile of m's program,
+// making an empty one if nothing has been profiled yet
+static profile_t *get_profile(machine_t *m)
+{
+    if (m->profile == NULL) {
+	m->profile = profile_create(m->instructions_loaded, m->PC);
+    }
+    return m->profile;
+}
+
+// Free the analysis of m's program, if any
+static void free_analysis(machine_t *m)
+{
+    if (m->analysis != NULL) {
+	analysis_destroy(m->analysis);
+	m->analysis = NULL;
+    }
+}
+
+// Return the analysis of m's program,
+// making an empty one if nothing has been analyzed yet
+static analysis_t *get_analysis(machine_t *m)
+{
+    if (m->analysis == NULL) {
+	m->analysis = analysis_create(m->cache_config, m->predictor_config,
+				      m->instructions_loaded);
+    }
+    return m->analysis;
+}
+
+// Free the machine m and everything it uses
+void machine_destroy(machine_t *m)
+{
+    output_flush(m);
+    free_blocks(m);
+    free_profile(m);
+    free_analysis(m);
+    if (m->trace_cache != NULL) {
+	trace_cache_destroy(m->trace_cache);
+    }
+    free(m->decoded);
+    free(m->leaders);
+    munmap(m, sizeof(machine_t));
+}
+
+// Requires: in can be read from and out and err can be written on
+// Make m read characters from in, write its program's output
+// and tracing output on out, and write error messages on err
+void machine_set_files(machine_t *m, FILE *in, FILE *out, FILE *err)
+{
+    output_flush(m);
+    m->in = in;
+    m->out = out;
+    m->err = err;
+}
+
+// Pass the output that m has buffered on to m->out
+static void output_flush(machine_t *m)
+{
+    if (m->output_used > 0) {
+	fwrite(m->output, 1, m->output_used, m->out);
+	if (m->trace != NULL) {
+	    trace_write_output(m->trace, m->output, m->output_used);
+	}
+	m->output_used = 0;
+    }
+}
+
+// Buffer the len bytes starting at s as output from m
+static void output_bytes(machine_t *m, const char *s, size_t len)
+{
+    if (m->output_used + len > OUTPUT_BUFFER_SIZE) {
+	output_flush(m);
+	if (len > OUTPUT_BUFFER_SIZE) {
+	    fwrite(s, 1, len, m->out);
+	    if (m->trace != NULL) {
+		trace_write_output(m->trace, s, len);
+	    }
+	    return;
+	}
+    }
+    memcpy(m->output + m->output_used, s, len);
+    m->output_used += len;
+}
+
+// Buffer the string s as output from m, and return its length
+// (as printf would, for the print_str system call)
+static int output_string(machine_t *m, const char *s)
+{
+    size_t len = strlen(s);
+    output_bytes(m, s, len);
+    return len;
+}
+
+// Buffer the decimal form of i as output from m, and return its length
+// (as printf would, for the print_int system call)
+static int output_int(machine_t *m, int i)
+{
+    char digits[12]; // room for "-2147483648"
+    char *p = digits + sizeof(digits);
+    unsigned int u = (i < 0) ? -(unsigned int)i : (unsigned int)i;
+    do {
+	*--p = '0' + u % 10;
+	u = u / 10;
+    } while (u != 0);
+    if (i < 0) {
+	*--p = '-';
+    }
+    int len = digits + sizeof(digits) - p;
+    output_bytes(m, p, len);
+    return len;
+}
+
+// Buffer the character c as output from m, and return it
+// (as fputc would, for the print_char system call)
+static int output_char(machine_t *m, int c)
+{
+    if (m->output_used == OUTPUT_BUFFER_SIZE) {
+	output_flush(m);
+    }
+    m->output[m->output_used++] = (unsigned char)c;
+    return (unsigned char)c;
+}
+
+// Print the message msg on m's error file (and in its binary trace),
+// after flushing m's output, then stop m with the given exit status
+static void machine_stop(machine_t *m, int status, const char *msg)
+{
+    output_flush(m);
+    fflush(m->out); // so the message comes after the program's output
+    fputs(msg, m->err);
+    fflush(m->err);
+    if (m->trace != NULL) {
+	trace_write_error(m->trace, msg);
+    }
+    m->running = false;
+    m->exit_status = status;
+}
+
+// Format an error message (as bail_with_error does) and print it
+// on m's error file, after flushing m's output,
+// then stop m with the exit status EXIT_FAILURE
+static void machine_error(machine_t *m, const char *fmt, ...)
+{
+    char buff[2048];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buff, sizeof(buff), fmt, args);
+    va_end(args);
+    char msg[sizeof(buff) + 256];
+    if (errno != 0) {
+	snprintf(msg, sizeof(msg), "%s: %s\n", buff, strerror(errno));
+    } else {
+	snprintf(msg, sizeof(msg), "%s\n", buff);
+    }
+    machine_stop(m, EXIT_FAILURE, msg);
+}
+
+// Return the number of milliseconds since m's program started running
+static unsigned long run_time_ms(machine_t *m)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - m->run_start.tv_sec) * 1000
+	+ (now.tv_nsec - m->run_start.tv_nsec) / 1000000;
+}
+
+// Set the instruction count at which m next checks its limits
+static void schedule_limit_check(machine_t *m)
+{
+    m->limit_check_at = (m->max_instrs == 0) ? ULONG_MAX : m->max_instrs;
+    if (m->max_ms != 0
+	&& m->instructions_executed + TIME_CHECK_INTERVAL < m->limit_check_at) {
+	m->limit_check_at = m->instructions_executed + TIME_CHECK_INTERVAL;
+    }
+}
+
+// Check m's limits on the instructions its program executes and the time
+// it runs for. If it is over one, this prints a summary on m's error file
+// and stops m with the exit status MACHINE_LIMIT_EXCEEDED, returning false.
+// (The engines only call this once m->limit_check_at instructions
+// have been executed, so limits without a clock cost one comparison.)
+static bool limits_okay(machine_t *m)
+{
+    char msg[256];
+    unsigned long ms = run_time_ms(m);
+    if (m->max_instrs != 0 && m->instructions_executed >= m->max_instrs) {
+	snprintf(msg, sizeof(msg),
+		 "Stopped at PC %u: the instruction limit (%lu) was reached,"
+		 " after %lu instructions in %lu ms\n", m->PC, m->max_instrs,
+		 m->instructions_executed, ms);
+	machine_stop(m, MACHINE_LIMIT_EXCEEDED, msg);
+	return false;
+    }
+    if (m->max_ms != 0 && ms >= m->max_ms) {
+	snprintf(msg, sizeof(msg),
+		 "Stopped at PC %u: the time limit (%lu ms) was reached,"
+		 " after %lu instructions in %lu ms\n", m->PC, m->max_ms,
+		 m->instructions_executed, ms);
+	machine_stop(m, MACHINE_LIMIT_EXCEEDED, msg);
+	return false;
+    }
+    schedule_limit_check(m);
+    return true;
+}
+
+// Check m's limits if it is time to (see limits_okay),
+// and leave the engine if m is over one
+#define ENGINE_CHECK_LIMITS()						\
+    if (m->instructions_executed >= m->limit_check_at && !limits_okay(m)) \
+	return
+
+// Zero the memory of m, if a program has used it, leaving as much
+// of the zeroing as possible to the OS, which zeroes each page
+// the next time it is touched
+static void zero_memory(machine_t *m)
+{
+    if (!m->memory_used) {
+	return; // it is still as mmap made it
+    }
+    size_t zeroed = 0;
+#ifdef __linux__
+    // (on Linux, dropping private anonymous pages zero-fills them)
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t whole_pages = (MEMORY_SIZE_IN_BYTES / page_size) * page_size;
+    if (madvise(m->memory.bytes, whole_pages, MADV_DONTNEED) == 0) {
+	zeroed = whole_pages;
+    }
+#endif
+    memset(m->memory.bytes + zeroed, 0, MEMORY_SIZE_IN_BYTES - zeroed);
+    m->memory_used = false;
+}
+
+// set up the state of the machine m
+static void initialize(machine_t *m)
 {
-    tracing = false;   // default for tracing
-    instructions_loaded = 0;
-    global_data_words = 0;
-    running = true;
+    m->tracing = false;   // default for tracing
+    m->trace_synced = false;
+    m->instructions_loaded = 0;
+    m->global_data_words = 0;
+    m->running = true;
+    m->exit_status = EXIT_SUCCESS;
+    m->instructions_executed = 0;
+    clock_gettime(CLOCK_MONOTONIC, &m->run_start);
+    schedule_limit_check(m);
+    free_blocks(m);
+    free_profile(m);
+    free_analysis(m);
 
     // zero the registers
     for (int j = 0; j < NUM_REGISTERS; j++) {
-	GPR[j] = 0;
-    }
-    hilo_regs.result = 0;
-    // zero out the memory
-    for (int i = 0; i < MEMORY_SIZE_IN_WORDS; i++) {
-	memory.words[i] = 0;
+	m->GPR[j] = 0;
     }
+    m->hilo_regs.result = 0;
+    zero_memory(m);
 }
 
 // Requires: bf is a binary object file that is open for reading
-// Load count instructions in bf into the memory starting at address 0.
-// If any errors are encountered, exit with an error message.
-static void load_instructions(BOFFILE bf, int count)
+// Load count instructions in bf into m's memory starting at address 0,
+// with one read, and return true.
+// If any errors are encountered, print an error message
+// on m's error file, stop m, and return false.
+static bool load_instructions(machine_t *m, BOFFILE bf, int count)
 {
-    for (int i = 0; i < count; i++) {
-	memory.instrs[i] = instruction_read(bf);
+    if (bof_read_words(bf, count, m->memory.words) != count) {
+	machine_error(m, "Cannot read instruction from %s", bf.filename);
+	return false;
     }
+    return true;
 }
 
 // Requires: bf is a binary object file that is open for reading
-// Load count words in bf into the memory starting at address global_base,
-// which is a word address.
-// If any errors are encountered, exit with an error message.
-static void load_data(BOFFILE bf, int count, unsigned int global_base)
+// Load count words in bf into m's memory starting at address global_base,
+// which is a word address, with one read, and return true.
+// If any errors are encountered, print an error message
+// on m's error file, stop m, and return false.
+static bool load_data(machine_t *m, BOFFILE bf, int count,
+		      unsigned int global_base)
 {
-    for (int i = 0; i < count; i++) {
-	memory.words[global_base+i] = bof_read_word(bf);
+    if (bof_read_words(bf, count, &m->memory.words[global_base]) != count) {
+	machine_error(m, "Cannot read the global data from %s", bf.filename);
+	return false;
     }
+    return true;
 }
 
-// Requires: bf is open for reading in binary
-// Load the binary object file bf, and get ready to run it
-void machine_load(BOFFILE bf)
+// Check that the BOF header bh describes a program
+// that fits in a machine's memory
+// (if not, print an error message on m's error file, stop m,
+// and return false)
+static bool header_okay(machine_t *m, BOFHeader bh)
 {
-    initialize();
-
-    // read and check the header
-    BOFHeader bh = bof_read_header(bf);
     if (bh.text_start_address % BYTES_PER_WORD != 0) {
-	bail_with_error("PC starting address (%u) is not divisible by %d!",
-			bh.text_start_address, BYTES_PER_WORD);
+	machine_error(m, "PC starting address (%u) is not divisible by %d!",
+			 bh.text_start_address, BYTES_PER_WORD);
+	return false;
     }
     if (bh.text_length >= bh.data_start_address) {
-	bail_with_error("%s (%u) %s (%u)!",
-			"Text, i.e., program length", bh.text_length,
-			"is not less than the start address of the global data",
-			bh.data_start_address);
+	machine_error(m, "%s (%u) %s (%u)!",
+			 "Text, i.e., program length", bh.text_length,
+			 "is not less than the start address of the global data",
+			 bh.data_start_address);
+	return false;
     }
     if (bh.data_start_address % BYTES_PER_WORD != 0) {
-	bail_with_error("Data start address (%u) is not divisible by %d",
-			bh.data_start_address, BYTES_PER_WORD);
+	machine_error(m, "Data start address (%u) is not divisible by %d",
+			 bh.data_start_address, BYTES_PER_WORD);
+	return false;
     }
-    if (bh.data_start_address + bh.data_length >= bh.stack_bottom_addr) {
-	bail_with_error("%s (%u) + %s (%u) %s (%u)!",
-			"Global data start address", bh.data_start_address,
-			"global data length", bh.data_length,
-			"is not less than the stack bottom address",
-			bh.stack_bottom_addr);
+    // (written so that a huge data length cannot wrap around)
+    if (bh.data_start_address >= bh.stack_bottom_addr
+	|| bh.data_length >= bh.stack_bottom_addr - bh.data_start_address) {
+	machine_error(m, "%s (%u) + %s (%u) %s (%u)!",
+			 "Global data start address", bh.data_start_address,
+			 "global data length", bh.data_length,
+			 "is not less than the stack bottom address",
+			 bh.stack_bottom_addr);
+	return false;
     }
     if (bh.stack_bottom_addr % BYTES_PER_WORD != 0) {
-	bail_with_error("Stack bottom address (%u) is not divisible by %d",
-			bh.stack_bottom_addr, BYTES_PER_WORD);
+	machine_error(m, "Stack bottom address (%u) is not divisible by %d",
+			 bh.stack_bottom_addr, BYTES_PER_WORD);
+	return false;
     }
     if (bh.stack_bottom_addr >= MEMORY_SIZE_IN_BYTES) {
-	bail_with_error("%s (%u) %s (%u)!",
-			"stack_bottom_addr", bh.stack_bottom_addr,
-			"is not less than the memory size",
-			MEMORY_SIZE_IN_BYTES);
+	machine_error(m, "%s (%u) %s (%u)!",
+			 "stack_bottom_addr", bh.stack_bottom_addr,
+			 "is not less than the memory size",
+			 MEMORY_SIZE_IN_BYTES);
+	return false;
+    }
+    return true;
+}
+
+// Requires: m->instructions_loaded words of instructions are in m's memory
+// Pre-decode m's loaded instructions, finding their leaders
+static void predecode(machine_t *m)
+{
+    // (one more element than needed, so an empty program allocates some)
+    free(m->decoded);
+    free(m->leaders);
+    m->decoded = (decoded_instr_t *)
+	malloc((m->instructions_loaded + 1) * sizeof(decoded_instr_t));
+    m->leaders = (bool *)malloc((m->instructions_loaded + 1) * sizeof(bool));
+    if (m->decoded == NULL || m->leaders == NULL) {
+	bail_with_error("Cannot allocate space to pre-decode the program!");
+    }
+    decode_program(m->memory.instrs, m->instructions_loaded, m->decoded);
+    decode_find_leaders(m->decoded, m->instructions_loaded, m->leaders);
+}
+
+// Requires: bf is open for reading in binary
+// Load the binary object file bf into m, and get ready to run it
+// (exiting with an error message if bf is not a valid BOF file)
+void machine_load(machine_t *m, BOFFILE bf)
+{
+    if (!machine_try_load(m, bf)) {
+	exit(machine_exit_status(m));
+    }
+}
+
+// Requires: bf is open for reading in binary
+// Load the binary object file bf into m, get ready to run it,
+// and return true; but if bf is not a valid BOF file,
+// print an error message on m's error file, stop m (so its exit status
+// is EXIT_FAILURE), and return false
+bool machine_try_load(machine_t *m, BOFFILE bf)
+{
+    initialize(m);
+    m->memory_used = true;
+    // read and check the header
+    BOFHeader bh;
+    if (fread(&bh, sizeof(bh), 1, bf.fileptr) != 1) {
+	machine_error(m, "Cannot read header from %s", bf.filename);
+	return false;
+    }
+    if (!header_okay(m, bh)) {
+	return false;
     }
+    m->header = bh;
 
     // load the program
-    instructions_loaded = bh.text_length / BYTES_PER_WORD;
-    load_instructions(bf, instructions_loaded);
+    m->instructions_loaded = bh.text_length / BYTES_PER_WORD;
+    if (!load_instructions(m, bf, m->instructions_loaded)) {
+	return false;
+    }
+    predecode(m);
 
-    global_data_words = bh.data_length / BYTES_PER_WORD;
+    m->global_data_words = bh.data_length / BYTES_PER_WORD;
     
-    load_data(bf, global_data_words,
-	      bh.data_start_address / BYTES_PER_WORD);
+    if (!load_data(m, bf, m->global_data_words,
+		   bh.data_start_address / BYTES_PER_WORD)) {
+	return false;
+    }
 
     // initialize the registers
-    PC = bh.text_start_address;
+    m->PC = bh.text_start_address;
 
     // save the address of the stack bottom, as specified in the BOF file
-    stack_bottom_address = bh.stack_bottom_addr;
+    m->stack_bottom_address = bh.stack_bottom_addr;
 
-    GPR[GP] = bh.data_start_address;
-    GPR[SP] = stack_bottom_address;
-    GPR[FP] = stack_bottom_address;
+    m->GPR[GP] = bh.data_start_address;
+    m->GPR[SP] = m->stack_bottom_address;
+    m->GPR[FP] = m->stack_bottom_address;
     // to simulate a call, put the stack bottom address in a0
-    GPR[A0] = stack_bottom_address;
+    m->GPR[A0] = m->stack_bottom_address;
+    return true;
 }
 
-// print the memory location at word address a to out
-// (using the byte address, whic is WORDS_PER_BYTE times a)
-// with a format determined by fmt and no newline,
-// returns the number of characters written
-static int print_loc(FILE *out, int a, char fmt)
+// Write the count words starting at ws to the snapshot file f,
+// which is named path (exiting with an error message if that fails)
+static void write_snapshot_words(FILE *f, const char *path,
+				 const word_type *ws, size_t count)
 {
-    int count;
-    if (fmt == 'x') {
-	count = fprintf(out, "%8d: 0x%x\t", a*BYTES_PER_WORD, memory.words[a]);
-    } else {
-	count = fprintf(out, "%8d: %d\t", a*BYTES_PER_WORD, memory.words[a]);
+    if (fwrite(ws, sizeof(word_type), count, f) != count) {
+	bail_with_error("Cannot write the snapshot %s!", path);
+    }
+}
+
+// Requires: a program has been loaded into m (and may have run)
+// Write a snapshot of m's state to the file named path, from which
+// machine_restore can start a machine where m is now.
+// A snapshot file starts with the 4 bytes "SRMS", followed by words
+// (in the byte order of the machine that wrote it): the loaded program's
+// BOF header (its 5 addresses and lengths), the PC, the NUM_REGISTERS
+// registers, HI, LO, 1 if tracing is on (e.g., after a STRA instruction)
+// or else 0, the number n of pages of memory that are not
+// all zero, then n pairs of a page number and that page's
+// SNAPSHOT_PAGE_SIZE bytes (all other pages are zero; the last page
+// is only as long as the rest of the memory)
+void machine_snapshot(machine_t *m, const char *path)
+{
+    output_flush(m); // (so the output so far comes before any later)
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+	bail_with_error("Cannot open %s for writing!", path);
+    }
+    fwrite(SNAPSHOT_MAGIC, 1, strlen(SNAPSHOT_MAGIC), f);
+    BOFHeader bh = m->header;
+    word_type header[] = {bh.text_start_address, bh.text_length,
+			  bh.data_start_address, bh.data_length,
+			  bh.stack_bottom_addr, m->PC};
+    write_snapshot_words(f, path, header, 6);
+    write_snapshot_words(f, path, m->GPR, NUM_REGISTERS);
+    word_type state[] = {m->hilo_regs.hilo[HI], m->hilo_regs.hilo[LO],
+			 m->tracing};
+    write_snapshot_words(f, path, state, 3);
+
+    // the pages that are not all zero, and how many of them there are
+    word_type pages[SNAPSHOT_PAGES];
+    word_type num_pages = 0;
+    for (unsigned int p = 0; p < SNAPSHOT_PAGES; p++) {
+	size_t start = p * SNAPSHOT_PAGE_SIZE;
+	size_t size = MEMORY_SIZE_IN_BYTES - start;
+	size = (size < SNAPSHOT_PAGE_SIZE) ? size : SNAPSHOT_PAGE_SIZE;
+	for (size_t i = 0; i < size; i++) {
+	    if (m->memory.bytes[start + i] != 0) {
+		pages[num_pages++] = p;
+		break;
+	    }
+	}
+    }
+    write_snapshot_words(f, path, &num_pages, 1);
+    for (unsigned int i = 0; i < num_pages; i++) {
+	size_t start = pages[i] * SNAPSHOT_PAGE_SIZE;
+	size_t size = MEMORY_SIZE_IN_BYTES - start;
+	size = (size < SNAPSHOT_PAGE_SIZE) ? size : SNAPSHOT_PAGE_SIZE;
+	write_snapshot_words(f, path, &pages[i], 1);
+	if (fwrite(&m->memory.bytes[start], 1, size, f) != size) {
+	    bail_with_error("Cannot write the snapshot %s!", path);
+	}
+    }
+    if (fclose(f) != 0) {
+	bail_with_error("Cannot write the snapshot %s!", path);
     }
-    return count;
 }
 
-// print the address given and 
-static void print_instruction(FILE *out, address_type a, bin_instr_t bi)
+// Read count words from the snapshot file f, which is named path,
+// into ws, and return true (but if that fails, print an error message
+// on m's error file, stop m, and return false)
+static bool read_snapshot_words(machine_t *m, FILE *f, const char *path,
+				word_type *ws, size_t count)
 {
-    fprintf(out, "%4d %s\n", a, instruction_assembly_form(bi));
+    if (fread(ws, sizeof(word_type), count, f) != count) {
+	machine_error(m, "The snapshot %s is truncated!", path);
+	return false;
+    }
+    return true;
 }
 
-// print the word memory in hex or decimal based on the fmt argument
-// between start (inclusive) and end (inclusive) to out,
-// without a newline and eliding most elements that are 0
-static bool print_memory_nonzero(FILE *out, int start, int end, char fmt)
+// Make m's state the one in the snapshot in the file named path
+// (see machine_snapshot), and get ready to run from there
+// (exiting with an error message if it is not a valid snapshot)
+void machine_restore(machine_t *m, const char *path)
 {
-    bool printed_trailing_newline = false;
-    bool no_dots_yet = true;
-    // count of chars on a line
-    int lc = 0;
-    for (int a = start; a <= end; a++) {
-	if (memory.words[a] != 0) {
-	    lc += print_loc(out, a, fmt);
-	    printed_trailing_newline = false;
-	    no_dots_yet = true;
-	} else { // memory.words[a] == 0
-	    if (no_dots_yet) {
-		lc += print_loc(out, a, fmt);
-		lc += fprintf(out, "...");
-		printed_trailing_newline = false;
-		no_dots_yet = false;
-	    }
+    if (!machine_try_restore(m, path)) {
+	exit(machine_exit_status(m));
+    }
+}
+
+// Read the rest of the snapshot f, which is named path and whose magic
+// number has been read, into the initialized machine m, and return true
+// (but if it is not a valid snapshot, print an error message
+// on m's error file, stop m, and return false)
+static bool restore_from(machine_t *m, FILE *f, const char *path)
+{
+    word_type header[6];
+    if (!read_snapshot_words(m, f, path, header, 6)) {
+	return false;
+    }
+    BOFHeader bh = {"BOF", header[0], header[1], header[2], header[3],
+		    header[4]};
+    if (!header_okay(m, bh)) {
+	return false;
+    }
+    m->header = bh;
+    m->PC = header[5];
+    word_type tracing;
+    if (!read_snapshot_words(m, f, path, m->GPR, NUM_REGISTERS)
+	|| !read_snapshot_words(m, f, path, &m->hilo_regs.hilo[HI], 1)
+	|| !read_snapshot_words(m, f, path, &m->hilo_regs.hilo[LO], 1)
+	|| !read_snapshot_words(m, f, path, &tracing, 1)) {
+	return false;
+    }
+    m->tracing = (tracing != 0);
+
+    word_type num_pages;
+    if (!read_snapshot_words(m, f, path, &num_pages, 1)) {
+	return false;
+    }
+    for (word_type i = 0; i < num_pages; i++) {
+	word_type p;
+	if (!read_snapshot_words(m, f, path, &p, 1)) {
+	    return false;
+	}
+	if ((address_type)p >= SNAPSHOT_PAGES) {
+	    machine_error(m, "The snapshot %s has a page (%d) outside memory!",
+			  path, p);
+	    return false;
 	}
-	if (lc > MAX_PRINT_WIDTH) {
-	    newline(out);
-	    printed_trailing_newline = true;
-	    lc = 0;
+	size_t start = p * SNAPSHOT_PAGE_SIZE;
+	size_t size = MEMORY_SIZE_IN_BYTES - start;
+	size = (size < SNAPSHOT_PAGE_SIZE) ? size : SNAPSHOT_PAGE_SIZE;
+	if (fread(&m->memory.bytes[start], 1, size, f) != size) {
+	    machine_error(m, "The snapshot %s is truncated!", path);
+	    return false;
 	}
     }
-    return printed_trailing_newline;
+    return true;
+}
+
+// Make m's state the one in the snapshot in the file named path
+// (see machine_snapshot), get ready to run from there, and return true;
+// but if it is not a valid snapshot, print an error message
+// on m's error file, stop m (so its exit status is EXIT_FAILURE),
+// and return false
+bool machine_try_restore(machine_t *m, const char *path)
+{
+    initialize(m);
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+	machine_error(m, "Cannot open %s for reading!", path);
+	return false;
+    }
+    char magic[sizeof(SNAPSHOT_MAGIC)] = "";
+    if (fread(magic, 1, strlen(SNAPSHOT_MAGIC), f) != strlen(SNAPSHOT_MAGIC)
+	|| strcmp(magic, SNAPSHOT_MAGIC) != 0) {
+	fclose(f);
+	machine_error(m, "%s is not a VM snapshot!", path);
+	return false;
+    }
+    m->memory_used = true;
+    bool okay = restore_from(m, f, path);
+    fclose(f);
+    if (!okay) {
+	return false;
+    }
+
+    m->instructions_loaded = m->header.text_length / BYTES_PER_WORD;
+    predecode(m);
+    m->global_data_words = m->header.data_length / BYTES_PER_WORD;
+    m->stack_bottom_address = m->header.stack_bottom_addr;
+    return true;
 }
 
-/*
-// print the nonzero memory locations between start and end on out,
-// in hexadecimal notation
-// a trailing newline was printed if the result is true
-static bool print_memory_words_x(FILE *out, int start, int end)
+// Return a view of m's state, for printing it
+static trace_state_t state_view(machine_t *m)
 {
-    return print_memory_nonzero(out, start, end, 'x');
+    trace_state_t s = {m->PC, m->GPR, m->hilo_regs.hilo[HI],
+		       m->hilo_regs.hilo[LO], m->memory.words,
+		       m->global_data_words, m->stack_bottom_address, NULL};
+    return s;
 }
-*/
 
-// print the nonzero memory locations between start and end on out,
-// in decimal notation
-// a trailing newline was printed if the result is true
-static bool print_memory_words_d(FILE *out, int start, int end)
+// Print m's non-zero global data from GPR[GP] for global_data_words
+static void print_global_data(machine_t *m, FILE *out)
 {
-    return print_memory_nonzero(out, start, end, 'd');
+    trace_state_t s = state_view(m);
+    trace_print_global_data(out, &s);
 }
 
-// Print the non-zero global data from GPR[GP] for global_data_words
-static void print_global_data(FILE *out)
+// Print m's state as tracing output: as text on m->out
+// (only walking the regions of memory that changed since the last state
+// printed when possible), or, when m has a binary trace, written to that,
+// as only what changed since the last state written when possible
+static void trace_state(machine_t *m)
 {
-    int global_wa = GPR[GP] / BYTES_PER_WORD;
-    bool printed_nl = print_memory_words_d(out, global_wa,
-					   global_wa + global_data_words);
-    if (!printed_nl) {
-	newline(out);
+    output_flush(m); // so the state comes after the program's output
+    if (m->trace == NULL) {
+	if (m->trace_cache == NULL) {
+	    m->trace_cache = trace_cache_create();
+	}
+	if (!m->trace_synced) {
+	    trace_cache_invalidate(m->trace_cache);
+	    m->trace_synced = true;
+	}
+	trace_state_t s = state_view(m);
+	s.cache = m->trace_cache;
+	trace_print_state(m->out, &s);
+	return;
+    }
+    if (!m->trace_synced) {
+	trace_state_t s = state_view(m);
+	trace_write_sync(m->trace, &s);
+	m->trace_synced = true;
+    } else {
+	// (the stores were written as they happened)
+	for (int j = 0; j < NUM_REGISTERS; j++) {
+	    if (m->GPR[j] != m->traced_GPR[j]) {
+		trace_write_register(m->trace, j, m->GPR[j]);
+	    }
+	}
+	if (m->hilo_regs.hilo[HI] != m->traced_hilo[HI]
+	    || m->hilo_regs.hilo[LO] != m->traced_hilo[LO]) {
+	    trace_write_hilo(m->trace, m->hilo_regs.hilo[HI],
+			     m->hilo_regs.hilo[LO]);
+	}
+	trace_write_state(m->trace, m->PC);
+    }
+    memcpy(m->traced_GPR, m->GPR, sizeof(m->traced_GPR));
+    memcpy(m->traced_hilo, m->hilo_regs.hilo, sizeof(m->traced_hilo));
+}
+
+// Trace the start of executing bi, at m's PC, as tracing output
+// (as text on out, or to m's binary trace, if it has one)
+static void trace_executing(machine_t *m, FILE *out, bin_instr_t bi)
+{
+    output_flush(m);
+    if (m->trace != NULL) {
+	trace_write_executing(m->trace, m->PC);
+    } else {
+	trace_print_executing(out, m->PC, bi);
     }
 }
 
-// Requires: a program has been loaded into the computer's memory
+// Requires: a program has been loaded into m's memory
 // print a heading and the program and any global data
-// that were previously loaded into the VM's memory to out
-void machine_print_loaded_program(FILE *out)
+// that were previously loaded into m's memory to out
+void machine_print_loaded_program(machine_t *m, FILE *out)
 {
     // heading
     instruction_print_table_heading(out);
     // instructions
-    for (int wa = 0; wa < instructions_loaded; wa++) {
-	print_instruction(out, wa*BYTES_PER_WORD, memory.instrs[wa]);
+    for (int wa = 0; wa < m->instructions_loaded; wa++) {
+	trace_print_instruction(out, wa*BYTES_PER_WORD, m->memory.instrs[wa]);
     }
 
-    print_global_data(out);
+    print_global_data(m, out);
 }
 
-// Run the VM on the already loaded program,
-// producing any trace output called for by the program
-void machine_run(bool should_trace)
+// Requires: wa == m->PC / BYTES_PER_WORD
+// Execute the instruction at word address wa the slow way,
+// printing tracing output if tracing is on
+static void step_traced(machine_t *m, address_type wa)
 {
-    tracing = should_trace;
+    m->instructions_executed++;
+    if (wa < m->instructions_loaded) {
+	if (m->tracing) {
+	    trace_executing(m, m->out, m->memory.instrs[wa]);
+	}
+	if (m->fusing) {
+	    // trace (and execute) one instruction at a time
+	    decoded_instr_t di = decode_instr(m->memory.instrs[wa], m->PC);
+	    execute_decoded(m, &di);
+	} else {
+	    execute_decoded(m, &m->decoded[wa]);
+	}
+	if (m->tracing && m->running) {
+	    trace_state(m);
+	}
+    } else {
+	machine_trace_execute_instr(m, m->out, m->memory.instrs[wa]);
+    }
+    if (m->running && m->instructions_executed >= m->limit_check_at) {
+	limits_okay(m);
+    }
+}
+
+// the engine used when invariants are checked before every instruction
+#define ENGINE_FN run_paranoid
+#define ENGINE_CHECK_EVERY_INSTR 1
+#include "machine_engine.h"
+
+// the engine used when invariants are only checked
+// after control transfers (branches and jumps)
+#define ENGINE_FN run_release
+#define ENGINE_CHECK_EVERY_INSTR 0
+#include "machine_engine.h"
+
+// the block engines, with the same checking as the engines above
+#define ENGINE_FN run_blocks_paranoid
+#define ENGINE_CHECK_EVERY_INSTR 1
+#include "machine_block_engine.h"
+
+#define ENGINE_FN run_blocks_release
+#define ENGINE_CHECK_EVERY_INSTR 0
+#include "machine_block_engine.h"
+
+// Execute the program loaded into m until m stops, an instruction
+// at a time, counting the executions of each instruction
+// and each kind of instruction, along with the outcomes
+// of each conditional branch (a branch to the next instruction
+// counts as not taken), in m's profile.
+// The profile also has a shadow call stack, which each JAL pushes
+// and each JR to the return address of a call on it pops,
+// and counts the instructions executed with each stack of calls.
+// When analyzing, it also feeds each load and store to m's simulated
+// cache, and each conditional branch to m's simulated branch predictor.
+// The other engines count nothing, so this is the only engine
+// that pays for profiling; the invariant is checked as they check it.
+static void run_profiled(machine_t *m)
+{
+    profile_t *p = get_profile(m);
+    analysis_t *a = m->analyzing ? get_analysis(m) : NULL;
+    bool check_each = (m->check_mode == paranoid_checking);
+    while (m->running) {
+	address_type wa = m->PC / BYTES_PER_WORD;
+	if (wa >= m->instructions_loaded) {
+	    // (outside the text, which is not profiled)
+	    if (!machine_okay(m)) {
+		return;
+	    }
+	    step_traced(m, wa);
+	    continue;
+	}
+	if (check_each && !machine_okay(m)) {
+	    return;
+	}
+	const decoded_instr_t *di = &m->decoded[wa];
+	handler_id h = di->handler;
+	if (a != NULL && (h == LW_H || h == LBU_H || h == SW_H || h == SB_H)) {
+	    // (the address is computed before a load can change GPR[rs])
+	    analysis_memory_access(a, wa, m->GPR[di->rs] + di->immed,
+				   h == SW_H || h == SB_H);
+	}
+	p->executions[wa]++;
+	p->handler_counts[h]++;
+	p->current->count++;
+	step_traced(m, wa);
+	if (h == JAL_H) {
+	    profile_call(p, m->PC, (wa + 1) * BYTES_PER_WORD);
+	} else if (h == JR_H) {
+	    profile_jump_register(p, m->PC);
+	}
+	bool is_branch = decode_is_branch(h);
+	if (is_branch && m->PC == (wa + 1) * BYTES_PER_WORD) {
+	    p->not_taken[wa]++;
+	} else if (is_branch) {
+	    p->taken[wa]++;
+	}
+	if (a != NULL && is_branch) {
+	    analysis_branch(a, wa, m->PC != (wa + 1) * BYTES_PER_WORD);
+	}
+	if (!check_each && m->running
+	    && (is_branch || h == JR_H || h == JMP_H || h == JAL_H)
+	    && !machine_okay(m)) {
+	    return;
+	}
+    }
+}
+
+// Pre-decode m's loaded text again, finding its leaders,
+// and fusing instructions if m->fusing is true
+static void redecode_text(machine_t *m)
+{
+    decode_program(m->memory.instrs, m->instructions_loaded, m->decoded);
+    decode_find_leaders(m->decoded, m->instructions_loaded, m->leaders);
+    if (m->fusing) {
+	decode_program_fused(m->memory.instrs, m->instructions_loaded,
+			     m->leaders, m->decoded);
+    }
+    if (m->threaded_labels != NULL) {
+	for (unsigned int i = 0; i < m->instructions_loaded; i++) {
+	    m->decoded[i].threaded = m->threaded_labels[m->decoded[i].handler];
+	}
+    }
+}
+
+// Requires: a program has been loaded into m
+// Run m on its loaded program until it stops,
+// producing any trace output called for by the program,
+// and return its exit status
+int machine_run(machine_t *m, bool should_trace)
+{
+    // (a STRA instruction run by machine_step, or before a snapshot
+    // was taken, may already have turned tracing on)
+    m->tracing = m->tracing || should_trace;
+    m->trace_synced = false;
+    clock_gettime(CLOCK_MONOTONIC, &m->run_start);
+    schedule_limit_check(m);
     
-    if (tracing) {
-	machine_print_state(stdout);
+    if (should_trace) {
+	trace_state(m);
+    }
+    // (each instruction is counted separately when profiling)
+    m->fusing = (m->check_mode == release_checking
+		 && !m->profiling && !m->analyzing);
+    if (m->fusing) {
+	redecode_text(m);
+    }
+    if (m->using_jit && m->jit == NULL) {
+	m->jit = jit_create(m->GPR, m->hilo_regs.hilo, m->memory.bytes,
+			    &m->PC, m->instructions_loaded);
+	// without the JIT, the program is still run a block at a time
+	m->using_jit = (m->jit != NULL);
     }
     // execute the program
-    while (running) {
-	machine_okay(); // check the invariant
-	machine_trace_execute_instr(stdout,
-				    memory.instrs[PC/BYTES_PER_WORD]);
+    if (m->profiling || m->analyzing) {
+	run_profiled(m);
+    } else if (m->using_blocks) {
+	if (m->blocks == NULL) {
+	    m->blocks = blocks_create(m->decoded, m->leaders,
+				      m->instructions_loaded);
+	}
+	if (m->check_mode == release_checking) {
+	    run_blocks_release(m);
+	} else {
+	    run_blocks_paranoid(m);
+	}
+    } else if (m->check_mode == release_checking) {
+	run_release(m);
+    } else {
+	run_paranoid(m);
+    }
+    output_flush(m);
+    return m->exit_status;
+}
+
+// Requires: a program has been loaded into m
+// Check m's invariant and execute m's next instruction
+// (printing tracing output if m is tracing),
+// returning true if m is still running afterwards
+bool machine_step(machine_t *m)
+{
+    if (!m->running || !machine_okay(m)) {
+	return false;
+    }
+    step_traced(m, m->PC / BYTES_PER_WORD);
+    output_flush(m);
+    return m->running;
+}
+
+// Return true if m has not stopped
+bool machine_running(machine_t *m)
+{
+    return m->running;
+}
+
+// Return the exit status of m once it has stopped
+int machine_exit_status(machine_t *m)
+{
+    return m->exit_status;
+}
+
+// Set how often m checks its invariant (with machine_okay)
+// while running programs
+void machine_set_check_mode(machine_t *m, check_mode_type mode)
+{
+    m->check_mode = mode;
+}
+
+// Set whether m runs programs a basic block at a time
+// (instead of an instruction at a time)
+void machine_set_block_mode(machine_t *m, bool use_blocks)
+{
+    m->using_blocks = use_blocks;
+}
+
+// Set whether m compiles the program's hot basic blocks
+// to native code (which also runs the program a block at a time,
+// and only checks the invariant between blocks)
+void machine_set_jit_mode(machine_t *m, bool use_jit)
+{
+    m->using_jit = use_jit;
+    if (use_jit) {
+	m->using_blocks = true;
+	m->check_mode = release_checking;
+    }
+}
+
+// Requires: trace is NULL or open for writing in binary
+// Make m write its tracing output to trace in binary form (see trace.h),
+// along with its program's output and its error messages,
+// or print it as text on its output file if trace is NULL
+void machine_set_binary_trace(machine_t *m, FILE *trace)
+{
+    output_flush(m);
+    m->trace = trace;
+    if (trace != NULL) {
+	trace_write_header(trace);
     }
 }
 
-// Load the given binary object file and run it,
-// tracing if should_trace is true
-void machine_load_and_run(BOFFILE bf, bool should_trace)
+// Limit the number of instructions the programs m runs may execute
+// to max_instrs, and the time they may run for to max_ms milliseconds
+// (where 0 means no limit). A program over a limit is stopped
+// with the exit status MACHINE_LIMIT_EXCEEDED. The limits are only
+// checked at branches and jumps (or between basic blocks),
+// so a program may go a little over them.
+void machine_set_limits(machine_t *m, unsigned long max_instrs,
+			unsigned long max_ms)
+{
+    m->max_instrs = max_instrs;
+    m->max_ms = max_ms;
+    schedule_limit_check(m);
+}
+
+// Set whether m runs programs with the profiling engine,
+// which counts the executions of each instruction (see machine_print_profile)
+// instead of running the program a block at a time or with the JIT
+void machine_set_profile_mode(machine_t *m, bool profile)
+{
+    m->profiling = profile;
+}
+
+// Print a report of the profile of m's program to out:
+// the executed instructions, from the most executed to the least,
+// with the outcomes of conditional branches,
+// and the number of executions of each kind of instruction
+void machine_print_profile(machine_t *m, FILE *out)
+{
+    profile_print_report(get_profile(m), m->memory.instrs, out);
+}
+
+// Write the profile of m's program to out in CSV form,
+// with one line for each instruction of the program
+// (see profile_write_csv in profile.h)
+void machine_write_profile_csv(machine_t *m, FILE *out)
+{
+    profile_write_csv(get_profile(m), m->memory.instrs, out);
+}
+
+// Write the instruction counts of each stack of calls in the profile
+// of m's program to out, in the folded-stack format read by flamegraph.pl,
+// naming procedures with the source map map if it is not NULL
+// (see profile_write_folded in profile.h)
+void machine_write_profile_folded(machine_t *m, source_map_t *map, FILE *out)
+{
+    profile_write_folded(get_profile(m), map, out);
+}
+
+// Requires: map is the source map of m's program
+// Print a report of the profile of m's program to out
+// in terms of its PL/0 source: the instructions executed for each
+// statement, and the source (read from source, unless that is NULL)
+// annotated with the instructions executed for each line
+void machine_print_source_profile(machine_t *m, source_map_t *map,
+				  FILE *source, FILE *out)
 {
-    machine_load(bf);
-    machine_run(should_trace);
+    profile_print_source_report(get_profile(m), map, source, out);
+}
+
+// Requires: analysis_cache_config_okay(cache)
+//        && analysis_predictor_config_okay(predictor)
+// Set whether m runs programs with the profiling engine, feeding
+// their memory accesses and branches to a simulated cache and branch
+// predictor of the given shapes (see machine_print_analysis)
+// instead of running the program a block at a time or with the JIT
+void machine_set_analysis_mode(machine_t *m, bool analyze,
+			       cache_config_t cache,
+			       predictor_config_t predictor)
+{
+    m->analyzing = analyze;
+    m->cache_config = cache;
+    m->predictor_config = predictor;
+    free_analysis(m);
+}
+
+// Print a report of the analysis of m's program to out:
+// the miss rates of the simulated cache and branch predictor,
+// overall and for each instruction that accessed memory or branched
+void machine_print_analysis(machine_t *m, FILE *out)
+{
+    analysis_print_report(get_analysis(m), m->memory.instrs, out);
+}
+
+// Print the execution count of each basic block of m's program to out
+// (only blocks that were executed, when running a block at a time)
+void machine_print_block_counts(machine_t *m, FILE *out)
+{
+    if (m->blocks == NULL) {
+	// no block has been executed, so print an empty table
+	m->blocks = blocks_create(m->decoded, m->leaders,
+				  m->instructions_loaded);
+    }
+    blocks_print_counts(m->blocks, out);
+}
+
+// Return the name of the dispatch engine m uses to run programs
+const char *machine_dispatch_name(machine_t *m)
+{
+    if (m->profiling || m->analyzing) {
+	return "profiling";
+    } else if (m->using_jit) {
+	return "jit";
+    } else if (m->using_blocks) {
+	return "block";
+    }
+#ifdef VM_THREADED_DISPATCH
+    return "threaded";
+#else
+    return "switch";
+#endif
+}
+
+// Return the number of instructions m has executed
+// since its program was loaded
+unsigned long machine_instruction_count(machine_t *m)
+{
+    if (m->block_running != NULL) {
+	// the block engine counts a block's instructions before running it
+	return m->instructions_executed
+	    - (m->block_running->end - m->block_next);
+    }
+    return m->instructions_executed;
+}
+
+// Load the given binary object file into m and run it,
+// tracing if should_trace is true, and return its exit status
+int machine_load_and_run(machine_t *m, BOFFILE bf, bool should_trace)
+{
+    machine_load(m, bf);
+    return machine_run(m, should_trace);
 }
 
 // If tracing then print bi, execute bi (always),
 // then if tracing print out the machine's state.
 // All tracing output goes to the FILE out
-void machine_trace_execute_instr(FILE *out, bin_instr_t bi)
+void machine_trace_execute_instr(machine_t *m, FILE *out, bin_instr_t bi)
 {
-    if (tracing) {
-	fprintf(out, "==> addr: ");
-	print_instruction(out, PC, bi);
+    if (m->tracing) {
+	trace_executing(m, out, bi);
     }
-    machine_execute_instr(bi);
-    if (tracing) {
-	machine_print_state(out);
+    machine_execute_instr(m, bi);
+    if (m->tracing && m->running && m->trace != NULL) {
+	trace_state(m);
+    } else if (m->tracing && m->running) {
+	machine_print_state(m, out);
     }
 }
 
-// Execute the given instruction, in the machine's current state
-void machine_execute_instr(bin_instr_t bi)
+// Execute the given instruction, in m's current state
+void machine_execute_instr(machine_t *m, bin_instr_t bi)
 {
-    // first, increment the PC
-    PC = PC + BYTES_PER_WORD;
-    
-    instr_type it = instruction_type(bi);
-    switch (it) {
-    case reg_instr_type:
-	{
-	    reg_instr_t ri = bi.reg;
-	    switch (ri.func) {
-	    case ADD_F:
-		GPR[ri.rd] = GPR[ri.rs] + GPR[ri.rt];
-		break;
-	    case SUB_F:
-		GPR[ri.rd] = GPR[ri.rs] - GPR[ri.rt];
-		break;
-	    case MUL_F:
-		hilo_regs.result = GPR[ri.rs] * GPR[ri.rt];
-		break;
-	    case DIV_F:
-		if (GPR[ri.rt] == 0) {
-		    bail_with_error("Attempt to divide by zero!");
-		}
-		hilo_regs.hilo[HI] = GPR[ri.rs] % GPR[ri.rt];
-		hilo_regs.hilo[LO] = GPR[ri.rs] / GPR[ri.rt];
-		break;
-	    case MFHI_F:
-		GPR[ri.rd] = hilo_regs.hilo[HI];
-		break;
-	    case MFLO_F:
-		GPR[ri.rd] = hilo_regs.hilo[LO];
-		break;
-	    case AND_F:
-		GPR[ri.rd] = GPR[ri.rs] & GPR[ri.rt];
-		break;
-	    case BOR_F:
-		GPR[ri.rd] = GPR[ri.rs] | GPR[ri.rt];
-		break;
-	    case NOR_F:
-		GPR[ri.rd] = ~(GPR[ri.rs] | GPR[ri.rt]);
-		break;
-	    case XOR_F:
-		GPR[ri.rd] = GPR[ri.rs] ^ GPR[ri.rt];
-		break;
-	    case SLL_F:
-		GPR[ri.rd] = GPR[ri.rt] << ri.shift;
-		break;
-	    case SRL_F:
-		GPR[ri.rd] = ((unsigned int)GPR[ri.rt]) >> ri.shift;
-		break;	
-	    case JR_F:
-		PC = GPR[ri.rs];
-		break;
-	    default:
-		bail_with_error("Invalid function code (%d) in machine_execute's register instruction case!",
-				ri.func);
-		break;
-	    }
+    decoded_instr_t di = decode_instr(bi, m->PC);
+    execute_decoded(m, &di);
+}
+
+// Requires: wa is the word address of a location that was just stored into
+// Keep the pre-decoded form of m's text section consistent with memory
+// (and, if m is tracing, record the store in m's binary trace,
+// if it has one, or in the cache of its text tracing output)
+static inline void note_store(machine_t *m, address_type wa)
+{
+    if (m->tracing && m->trace != NULL) {
+	trace_write_store(m->trace, wa, m->memory.words[wa]);
+    } else if (m->tracing && m->trace_cache != NULL) {
+	trace_cache_note_store(m->trace_cache, wa);
+    }
+    if (wa < m->instructions_loaded && m->blocks != NULL) {
+	// the blocks may have changed, so start over
+	redecode_text(m);
+	blocks_flush(m->blocks);
+	if (m->jit != NULL) {
+	    jit_flush(m->jit);
 	}
-	break;
-    case syscall_instr_type:
-	switch (instruction_syscall_number(bi)) {
-	case exit_sc:
-	    running = false;
-	    exit(0);
-	    break;
-	case print_str_sc:
-	    GPR[V0] = printf("%s", &memory.bytes[GPR[A0]]);
-	    break;
-	case print_char_sc:
-	    GPR[V0] = fputc(GPR[A0], stdout);
-	    break;
-	case print_int_sc:
-	    GPR[V0] = printf("%d", GPR[A0]);
-	    break;
-	case read_char_sc:
-	    GPR[V0] = getc(stdin);
-	    break;
-	case start_tracing_sc:
-	    tracing = true;
-	    break;
-	case stop_tracing_sc:
-	    tracing = false;
-	    break;
-	default:
-	    bail_with_error("Invalid system call type (%d) in machine_execute's syscall instruction case!",
-			    instruction_syscall_number(bi));
+	m->block_stop = 0;
+    } else if (wa < m->instructions_loaded) {
+	// a superinstruction starting before wa may include it
+	address_type first = wa;
+	if (m->fusing) {
+	    first = (wa < MAX_FUSED_INSTRS) ? 0 : wa - (MAX_FUSED_INSTRS - 1);
 	}
-	break;
-    case immed_instr_type:
-	{
-	    immed_instr_t ii = bi.immed;
-	    switch (ii.op) {
-	    case ADDI_O:
-		GPR[ii.rt] = GPR[ii.rs] + machine_types_sgnExt(ii.immed);
-		break;
-	    case ANDI_O:
-		GPR[ii.rt] = GPR[ii.rs] & machine_types_zeroExt(ii.immed);
-		break;
-	    case BORI_O:
-		GPR[ii.rt] = GPR[ii.rs] | machine_types_zeroExt(ii.immed);
-		break;
-	    case XORI_O:
-		GPR[ii.rt] = GPR[ii.rs] ^ machine_types_zeroExt(ii.immed);
-		break;
-	    case BEQ_O:
-		if (GPR[ii.rs] == GPR[ii.rt]) {
-		    PC = PC + machine_types_formOffset(ii.immed);
-		}
-		break;
-	    case BGEZ_O:
-		if (GPR[ii.rs] >= 0) {
-		    PC = PC + machine_types_formOffset(ii.immed);
-		}
-		break;
-	    case BGTZ_O:
-		if (GPR[ii.rs] > 0) {
-		    PC = PC + machine_types_formOffset(ii.immed);
-		}
-		break;
-	    case BLEZ_O:
-		if (GPR[ii.rs] <= 0) {
-		    PC = PC + machine_types_formOffset(ii.immed);
-		}
-		break;
-	    case BLTZ_O:
-		if (GPR[ii.rs] < 0) {
-		    PC = PC + machine_types_formOffset(ii.immed);
-		}
-		break;
-	    case BNE_O:
-		if (GPR[ii.rs] != GPR[ii.rt]) {
-		    PC = PC + machine_types_formOffset(ii.immed);
-		}
-		break;
-	    case LBU_O:
-		{
-		    address_type ba = GPR[ii.rs] + machine_types_formOffset(ii.immed);
-		    GPR[ii.rt] = machine_types_zeroExt(memory.bytes[ba]);
-		}
-		break;
-	    case LW_O:
-		{
-		    address_type wa = (GPR[ii.rs] + machine_types_formOffset(ii.immed))
-			/ BYTES_PER_WORD;
-		    GPR[ii.rt] = memory.words[wa];
-		}
-		break;
-	    case SB_O:
-		{
-		    address_type ba = GPR[ii.rs] + machine_types_formOffset(ii.immed);
-		    memory.bytes[ba] = GPR[ii.rt];
-		}
-		break;
-	    case SW_O:
-		{
-		    address_type wa = (GPR[ii.rs] + machine_types_formOffset(ii.immed))
-			/ BYTES_PER_WORD;
-		    memory.words[wa] = GPR[ii.rt];
-		}
-		break;
-	    default:
-		bail_with_error("Invalid opcode (%d) in machine_execute's immediate instruction case!",
-				ii.op);	    
-		break;
+	for (address_type i = first; i <= wa; i++) {
+	    if (m->fusing) {
+		m->decoded[i] = decode_fused_instr(m->memory.instrs,
+						   m->instructions_loaded,
+						   m->leaders, i);
+	    } else {
+		m->decoded[i] = decode_instr(m->memory.instrs[i],
+					     i * BYTES_PER_WORD);
 	    }
-	}
-	break;
-    case jump_instr_type:
-	{
-	    jump_instr_t ji = bi.jump;
-	    switch (ji.op) {
-	    case JMP_O:
-		PC = machine_types_formAddress(PC, ji.addr);
-		break;
-	    case JAL_O:
-		GPR[RA] = PC;
-		PC = machine_types_formAddress(PC, ji.addr);
-		break;
-	    default:
-		bail_with_error("Invalid opcode (%d) in machine_execute's jump instruction case!",
-				ji.op);	    
-		break;
+	    if (m->threaded_labels != NULL) {
+		m->decoded[i].threaded
+		    = m->threaded_labels[m->decoded[i].handler];
 	    }
 	}
-	break;
-    default:
-	bail_with_error("Invalid instruction type (%d) in machine_execute!",
-			it);
-	break;
     }
 }
 
-#define    REGFORMAT1 "GPR[%-3s]: %-4d"
-#define    REGFORMAT2 "\tGPR[%-3s]: %-4d"
+// Execute the pre-decoded instruction di, in m's current state
+static void execute_decoded(machine_t *m, const decoded_instr_t *di)
+{
+    // first, increment the PC
+    m->PC = m->PC + BYTES_PER_WORD;
 
-// Requires: out != NULL and out can be written on
-// Print the current values in the registers to out
-static void print_registers(FILE *out)
-{
-    // print the registers
-    fprintf(out, "%8s: %u", "PC", PC);
-    if (hilo_regs.result != 0L) {
-	fprintf(out, "\t%8s: %d\t%8s: %d", "HI", hilo_regs.hilo[HI], "LO", hilo_regs.hilo[LO]);
-    }
-    newline(out);
-    int j;
-
-    for (j = 0; j < (NUM_REGISTERS - 6); /* nothing */) {
-	fprintf(out, REGFORMAT1, regname_get(j), GPR[j]);
-	j++;
-	for (int i = 0; i < 5; i++) {
-	    fprintf(out, REGFORMAT2, regname_get(j), GPR[j]);
-	    j++;
-	}
-	newline(out);
+    switch (di->handler) {
+#define HANDLER(h) case h:
+#define END_HANDLER break;
+#define END_TRANSFER_HANDLER break;
+#define TRACING_TURNED_ON()
+#define ACCOUNT_FOR_FUSED() ADVANCE_PAST_FUSED(di)
+#define MACHINE_STOPPED() return
+#include "machine_handlers.h"
+#undef HANDLER
+#undef END_HANDLER
+#undef END_TRANSFER_HANDLER
+#undef TRACING_TURNED_ON
+#undef ACCOUNT_FOR_FUSED
+#undef MACHINE_STOPPED
+    default:
+	machine_error(m, "Invalid handler (%d) in execute_decoded!",
+		      di->handler);
+	break;
     }
-    fprintf(out, REGFORMAT1, regname_get(j), GPR[j]);
-    j++;
-    fprintf(out, REGFORMAT2, regname_get(j), GPR[j]);
-    j++;
-    newline(out);
 }
 
+// Requires: out != NULL and out can be written on
+// print the state of m (registers, globals, and
+// the memory between GPR[$sp] and GPR[$fp], inclusive) to out
+void machine_print_state(machine_t *m, FILE *out)
+{
+    output_flush(m); // so the state comes after the program's output
+    trace_state_t s = state_view(m);
+    trace_print_state(out, &s);
+}
 
-// Print non-zero global data between GPR[SP] and stack_bottom_address
-static void print_runtime_stack_AR(FILE *out)
+// Report that the part of m's invariant whose text is given,
+// on the given line of this file, does not hold,
+// in the same form as a failure of the assert macro,
+// and stop m with the exit status MACHINE_INVARIANT_FAILURE
+// (m's output is passed on to m->out, but not flushed,
+// as abort would not flush it; m's binary trace is flushed, though,
+// as it would be useless otherwise)
+static void invariant_failed(machine_t *m, const char *text, int line)
 {
-    // print the memory between sp and stack_bottom_address, inclusive
-    bool printed_nl
-	= print_memory_words_d(out,
-			       GPR[SP] / BYTES_PER_WORD,
-			       (stack_bottom_address / BYTES_PER_WORD)+1);
-    if (!printed_nl) {
-	newline(out);
+    output_flush(m);
+    char msg[1024];
+    int len = 0;
+#ifdef __GLIBC__
+    len = snprintf(msg, sizeof(msg), "%s: ", program_invocation_short_name);
+#endif
+    snprintf(msg + len, sizeof(msg) - len,
+	     "%s:%d: machine_okay: Assertion `%s' failed.\n",
+	     __FILE__, line, text);
+    fputs(msg, m->err);
+    fflush(m->err);
+    if (m->trace != NULL) {
+	trace_write_error(m->trace, msg);
+	fflush(m->trace);
     }
+    m->running = false;
+    m->exit_status = MACHINE_INVARIANT_FAILURE;
 }
 
-// Requires: out != NULL and out can be written on
-// print the state of the machine (registers, globals, and
-// the memory between GPR[$sp] and GPR[$fp], inclusive) to out
-void machine_print_state(FILE *out)
-{
-    print_registers(out);
-    print_global_data(out);
-    print_runtime_stack_AR(out);
-}
-
-// Invariant test for the VM (for debugging purposes)
-// This exits with an assertion error if the invariant does not pass
-void machine_okay()
-{
-    assert(PC % BYTES_PER_WORD == 0);
-    assert(GPR[GP] % BYTES_PER_WORD == 0);
-    assert(GPR[SP] % BYTES_PER_WORD == 0);
-    assert(GPR[FP] % BYTES_PER_WORD == 0);
-    assert(0 <= GPR[GP]);
-    assert(GPR[GP] < GPR[SP]);
-    assert(GPR[SP] <= GPR[FP]);
-    assert(GPR[FP] < MEMORY_SIZE_IN_BYTES);
-    assert(GPR[0] == 0);
+// Check that cond holds in m, as part of its invariant,
+// and if not, report that and return false from machine_okay
+#define INVARIANT(cond)							\
+    do {								\
+	if (!(cond)) {							\
+	    invariant_failed(m, #cond, __LINE__);			\
+	    return false;						\
+	}								\
+    } while (0)
+
+// Invariant test for the VM (for debugging purposes).
+// If the invariant does not hold in m, this reports the failure
+// (as the assert macro would) and stops m, returning false
+bool machine_okay(machine_t *m)
+{
+    // (named as in the messages that report a failure)
+    address_type PC = m->PC;
+    const word_type *GPR = m->GPR;
+    INVARIANT(PC % BYTES_PER_WORD == 0);
+    INVARIANT(GPR[GP] % BYTES_PER_WORD == 0);
+    INVARIANT(GPR[SP] % BYTES_PER_WORD == 0);
+    INVARIANT(GPR[FP] % BYTES_PER_WORD == 0);
+    INVARIANT(0 <= GPR[GP]);
+    INVARIANT(GPR[GP] < GPR[SP]);
+    INVARIANT(GPR[SP] <= GPR[FP]);
+    INVARIANT(GPR[FP] < MEMORY_SIZE_IN_BYTES);
+    INVARIANT(GPR[0] == 0);
+    return true;
 }
@@ -1,49 +1,218 @@
 /* $Id: machine.h,v 1.8 2023/11/14 18:29:49 leavens Exp leavens $ */
 #ifndef _MACHINE_H
 #define _MACHINE_H
+#include <stdio.h>
+#include <stdbool.h>
 #include <assert.h>
 #include "machine_types.h"
 #include "bof.h"
 #include "instruction.h"
+#include "source_map.h"
+#include "analysis.h"
 
 // a size for the memory (2^16 bytes = 64K)
 #define MEMORY_SIZE_IN_BYTES (65536 - BYTES_PER_WORD)
 #define MEMORY_SIZE_IN_WORDS (MEMORY_SIZE_IN_BYTES / BYTES_PER_WORD)
 
+// the exit status of a machine whose invariant failed
+// (what a shell reports for a process stopped by abort)
+#define MACHINE_INVARIANT_FAILURE 134
+
+// the exit status of a machine stopped for going over its limits
+// (see machine_set_limits), as the timeout command would report it
+#define MACHINE_LIMIT_EXCEEDED 124
+
+// how often the VM checks its invariant while running:
+// paranoid_checking checks before every instruction (the default),
+// release_checking only checks after each branch or jump
+typedef enum {paranoid_checking, release_checking} check_mode_type;
+
+// a virtual machine, with its own memory, registers, and loaded program.
+// Any number of machines can exist at once, and each stops independently:
+// the exit system call, a run-time error (e.g., a division by zero),
+// or a failure of the invariant only stops the machine it happens in,
+// giving it an exit status (see machine_exit_status).
+typedef struct machine_s machine_t;
+
+// Return a new machine, with nothing loaded,
+// which reads from stdin and writes on stdout and stderr
+extern machine_t *machine_create();
+
+// Free the machine m and everything it uses
+extern void machine_destroy(machine_t *m);
+
+// Requires: in can be read from and out and err can be written on
+// Make m read characters from in, write its program's output
+// and tracing output on out, and write error messages on err
+extern void machine_set_files(machine_t *m, FILE *in, FILE *out, FILE *err);
+
+// Set how often m checks its invariant (with machine_okay)
+// while running programs
+extern void machine_set_check_mode(machine_t *m, check_mode_type mode);
+
 // Requires: bf is open for reading in binary
-// Load the binary object file bf, and get ready to run it
-extern void machine_load(BOFFILE bf);
+// Load the binary object file bf into m, and get ready to run it
+// (exiting with an error message if bf is not a valid BOF file)
+extern void machine_load(machine_t *m, BOFFILE bf);
+
+// Requires: bf is open for reading in binary
+// Load the binary object file bf into m, get ready to run it,
+// and return true; but if bf is not a valid BOF file,
+// print an error message on m's error file, stop m (so its exit status
+// is EXIT_FAILURE), and return false
+extern bool machine_try_load(machine_t *m, BOFFILE bf);
+
+// Requires: a program has been loaded into m (and may have run)
+// Write a snapshot of m's state to the file named path: its memory
+// (only the pages that are not all zero), registers, and PC,
+// with the loaded program's BOF header, from which machine_restore
+// can start a machine where m is now, without running the program
+// up to here again (exiting with an error message if that fails)
+extern void machine_snapshot(machine_t *m, const char *path);
+
+// Make m's state the one in the snapshot in the file named path
+// (see machine_snapshot), and get ready to run from there
+// (exiting with an error message if it is not a valid snapshot)
+extern void machine_restore(machine_t *m, const char *path);
+
+// Make m's state the one in the snapshot in the file named path
+// (see machine_snapshot), get ready to run from there, and return true;
+// but if it is not a valid snapshot, print an error message
+// on m's error file, stop m (so its exit status is EXIT_FAILURE),
+// and return false
+extern bool machine_try_restore(machine_t *m, const char *path);
+
+// Requires: a program has been loaded into m's memory
+// print a heading and the program in m's memory to out
+extern void machine_print_loaded_program(machine_t *m, FILE *out);
+
+// Requires: a program has been loaded into m
+// Run m on its loaded program until it stops,
+// producing trace output by default if should_trace is true,
+// and return its exit status (see machine_exit_status)
+extern int machine_run(machine_t *m, bool should_trace);
 
-// Requires: a program has been loaded into the computer's memory
-// print a heading and the program in the VM's memory to out
-extern void machine_print_loaded_program(FILE *out);
+// Requires: a program has been loaded into m
+// Check m's invariant and execute m's next instruction
+// (printing tracing output if m is tracing),
+// returning true if m is still running afterwards
+extern bool machine_step(machine_t *m);
 
-// Run the VM on the already loaded program,
-// producing trace output by default if should_trace is true
-extern void machine_run(bool should_trace);
+// Return true if m has not stopped
+extern bool machine_running(machine_t *m);
 
-// Load the given binary object file and run it,
-// tracing if should_trace is true
-extern void machine_load_and_run(BOFFILE bf, bool should_trace);
+// Return the exit status of m once it has stopped:
+// EXIT_SUCCESS after the exit system call, EXIT_FAILURE after a
+// run-time error, MACHINE_INVARIANT_FAILURE if its invariant failed,
+// or MACHINE_LIMIT_EXCEEDED if it went over its limits
+extern int machine_exit_status(machine_t *m);
+
+// Load the given binary object file into m and run it,
+// tracing if should_trace is true, and return its exit status
+extern int machine_load_and_run(machine_t *m, BOFFILE bf, bool should_trace);
 
 // If tracing then print bi, execute bi (always),
 // then if tracing print out the machine's state.
 // All tracing output goes to the FILE out
-extern void machine_trace_execute_instr(FILE *out, bin_instr_t bi);
+extern void machine_trace_execute_instr(machine_t *m, FILE *out,
+					bin_instr_t bi);
 
-// Execute the given instruction, in the machine's current state
-extern void machine_execute_instr(bin_instr_t bi);
+// Execute the given instruction, in m's current state
+extern void machine_execute_instr(machine_t *m, bin_instr_t bi);
 
 // Requires: out != NULL and out can be written on
-// print the state of the machine (registers, globals, and
+// print the state of m (registers, globals, and
 // the memory between GPR[$sp] and GPR[$fp], inclusive) to out
-extern void machine_print_state(FILE *out);
+extern void machine_print_state(machine_t *m, FILE *out);
+
+// Set whether m runs programs a basic block at a time
+// (instead of an instruction at a time)
+extern void machine_set_block_mode(machine_t *m, bool use_blocks);
+
+// Set whether m compiles the program's hot basic blocks
+// to native code (which also runs the program a block at a time,
+// and only checks the invariant between blocks)
+extern void machine_set_jit_mode(machine_t *m, bool use_jit);
+
+// Requires: trace is NULL or open for writing in binary
+// Make m write its tracing output to trace in binary form (see trace.h),
+// along with its program's output and its error messages,
+// or print it as text on its output file if trace is NULL
+extern void machine_set_binary_trace(machine_t *m, FILE *trace);
+
+// Limit the number of instructions the programs m runs may execute
+// to max_instrs, and the time they may run for to max_ms milliseconds
+// (where 0 means no limit). A program over a limit is stopped
+// with the exit status MACHINE_LIMIT_EXCEEDED. The limits are only
+// checked at branches and jumps (or between basic blocks),
+// so a program may go a little over them.
+extern void machine_set_limits(machine_t *m, unsigned long max_instrs,
+			       unsigned long max_ms);
+
+// Set whether m runs programs with the profiling engine,
+// which counts the executions of each instruction (see machine_print_profile)
+// instead of running the program a block at a time or with the JIT
+extern void machine_set_profile_mode(machine_t *m, bool profile);
+
+// Print a report of the profile of m's program to out:
+// the executed instructions, from the most executed to the least,
+// with the outcomes of conditional branches,
+// and the number of executions of each kind of instruction
+extern void machine_print_profile(machine_t *m, FILE *out);
+
+// Write the profile of m's program to out in CSV form,
+// with one line for each instruction of the program
+// (see profile_write_csv in profile.h)
+extern void machine_write_profile_csv(machine_t *m, FILE *out);
+
+// Write the instruction counts of each stack of calls in the profile
+// of m's program to out, in the folded-stack format read by flamegraph.pl,
+// naming procedures with the source map map if it is not NULL
+// (see profile_write_folded in profile.h)
+extern void machine_write_profile_folded(machine_t *m, source_map_t *map,
+					 FILE *out);
+
+// Requires: map is the source map of m's program
+// Print a report of the profile of m's program to out
+// in terms of its PL/0 source: the instructions executed for each
+// statement, and the source (read from source, unless that is NULL)
+// annotated with the instructions executed for each line
+extern void machine_print_source_profile(machine_t *m, source_map_t *map,
+					 FILE *source, FILE *out);
+
+// Requires: analysis_cache_config_okay(cache)
+//        && analysis_predictor_config_okay(predictor)
+// Set whether m runs programs with the profiling engine, feeding
+// their memory accesses and branches to a simulated cache and branch
+// predictor of the given shapes (see machine_print_analysis)
+// instead of running the program a block at a time or with the JIT
+extern void machine_set_analysis_mode(machine_t *m, bool analyze,
+				      cache_config_t cache,
+				      predictor_config_t predictor);
+
+// Print a report of the analysis of m's program to out:
+// the miss rates of the simulated cache and branch predictor,
+// overall and for each instruction that accessed memory or branched
+// (see analysis_print_report in analysis.h)
+extern void machine_print_analysis(machine_t *m, FILE *out);
+
+// Print the execution count of each basic block of m's program to out
+// (only blocks that were executed, when running a block at a time)
+extern void machine_print_block_counts(machine_t *m, FILE *out);
+
+// Return the name of the dispatch engine m uses to run programs
+// ("profiling" when profiling or analyzing, "jit" when compiling blocks to native code,
+// "block" when running a block at a time, otherwise the engine
+// this VM was built with, "threaded" or "switch")
+extern const char *machine_dispatch_name(machine_t *m);
 
-// Print instr, execute instr, then print out the machine's state (to out)
-extern void machine_trace_execute(FILE *out, bin_instr_t instr);
+// Return the number of instructions m has executed
+// since its program was loaded
+extern unsigned long machine_instruction_count(machine_t *m);
 
-// Invariant test for the VM (for debugging purposes)
-// This exits with an assertion error if the invariant does not pass
-extern void machine_okay();
+// Invariant test for the VM (for debugging purposes).
+// If the invariant does not hold in m, this reports the failure
+// (as the assert macro would) and stops m, returning false
+extern bool machine_okay(machine_t *m);
 
 #endif
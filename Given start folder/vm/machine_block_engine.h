@@ -0,0 +1,104 @@
+/* $Id$ */
+// A template for the VM's basic block run loop.
+// This file is not a normal header: machine.c includes it once for each
+// variant of the block engine it needs, after defining
+// ENGINE_FN and ENGINE_CHECK_EVERY_INSTR (as for machine_engine.h).
+// The function defined executes the program loaded into the machine m
+// a basic block at a time (see blocks.h), going from each block straight to the next
+// through the links between them, so the PC is only set once per block.
+// The machine's limits are checked between blocks.
+// When the invariant is not checked before every instruction,
+// blocks that the JIT has compiled run as native code.
+// All of the macros above are undefined at the end of this file.
+
+#if ENGINE_CHECK_EVERY_INSTR
+#define ENGINE_CHECK_EACH() if (!machine_okay(m)) return
+#define ENGINE_CHECK_BLOCK()
+#else
+#define ENGINE_CHECK_EACH()
+#define ENGINE_CHECK_BLOCK() if (!machine_okay(m)) return
+#endif
+
+// Execute m's loaded program one basic block at a time
+static void ENGINE_FN(machine_t *m)
+{
+    block_t *b = NULL; // the block at the PC, if known
+    while (m->running) {
+	address_type wa = m->PC / BYTES_PER_WORD;
+	if (m->tracing || wa >= m->instructions_loaded) {
+	    // the slow path always checks
+	    if (!machine_okay(m)) {
+		return;
+	    }
+	    step_traced(m, wa);
+	    b = NULL;
+	    continue;
+	}
+	if (b == NULL) {
+	    b = blocks_lookup(m->blocks, wa);
+	}
+	b->count++;
+	m->instructions_executed += b->end - b->first;
+	// no instruction in a block but the last one uses the PC
+	m->PC = b->end * BYTES_PER_WORD;
+	m->block_running = b;
+	m->block_stop = b->end;
+	m->block_next = b->first;
+#if !ENGINE_CHECK_EVERY_INSTR
+	// (native code cannot check the invariant between instructions)
+	if (b->native != NULL) {
+	    m->block_next = b->native();
+	} else if (m->jit != NULL && b->count == JIT_HOT_COUNT) {
+	    jit_compile_block(m->jit, b, m->memory.instrs);
+	}
+#endif
+	while (m->block_next < m->block_stop) {
+	    const decoded_instr_t *di = &m->decoded[m->block_next];
+	    ENGINE_CHECK_EACH();
+	    m->block_next += di->length;
+	    switch (di->handler) {
+#define HANDLER(h) case h:
+#define END_HANDLER break;
+#define END_TRANSFER_HANDLER break;
+#define TRACING_TURNED_ON() trace_state(m)
+#define ACCOUNT_FOR_FUSED()
+#define MACHINE_STOPPED() return
+#include "machine_handlers.h"
+#undef HANDLER
+#undef END_HANDLER
+#undef END_TRANSFER_HANDLER
+#undef TRACING_TURNED_ON
+#undef ACCOUNT_FOR_FUSED
+#undef MACHINE_STOPPED
+	    default:
+		machine_error(m, "Invalid handler (%d) in the VM's block loop!",
+			      di->handler);
+		return;
+	    }
+	}
+	m->block_running = NULL;
+	if (m->block_stop != b->end) {
+	    // a store into the text ended the block early, at block_next
+	    m->PC = m->block_next * BYTES_PER_WORD;
+	    m->instructions_executed -= b->end - m->block_next;
+	    b = NULL;
+	    continue;
+	}
+	ENGINE_CHECK_BLOCK();
+	ENGINE_CHECK_LIMITS();
+	// go to the next block, through the links when possible
+	wa = m->PC / BYTES_PER_WORD;
+	if (wa == b->end && b->fallthrough != NULL) {
+	    b = b->fallthrough;
+	} else if (b->taken != NULL && wa == b->taken->first) {
+	    b = b->taken;
+	} else {
+	    b = blocks_chain(m->blocks, b, wa);
+	}
+    }
+}
+
+#undef ENGINE_CHECK_EACH
+#undef ENGINE_CHECK_BLOCK
+#undef ENGINE_FN
+#undef ENGINE_CHECK_EVERY_INSTR
@@ -0,0 +1,144 @@
+/* $Id$ */
+// A template for the VM's run loop.
+// This file is not a normal header: machine.c includes it once for each
+// variant of the run loop it needs, after defining:
+//   ENGINE_FN, the name of the (static) function to define, and
+//   ENGINE_CHECK_EVERY_INSTR, which is 1 if machine_okay(m) should be
+//     called before every instruction, and 0 if it should only be
+//     called after branches and jumps.
+// The function defined executes the program loaded into the machine m
+// until m stops, checking m's limits after each branch or jump
+// (with ENGINE_CHECK_LIMITS, from machine.c).
+// Which dispatch technique it uses depends on VM_THREADED_DISPATCH.
+// All of the macros above are undefined at the end of this file.
+
+#if ENGINE_CHECK_EVERY_INSTR
+#define ENGINE_CHECK_EACH() if (!machine_okay(m)) return
+#define ENGINE_CHECK_TRANSFER()
+#else
+#define ENGINE_CHECK_EACH()
+#define ENGINE_CHECK_TRANSFER() if (!machine_okay(m)) return
+#endif
+
+#ifdef VM_THREADED_DISPATCH
+// Execute the loaded program with direct-threaded dispatch:
+// each pre-decoded instruction holds the address of its handler's label,
+// and each handler jumps straight to the next instruction's handler.
+static void ENGINE_FN(machine_t *m)
+{
+    static const void *labels[NUM_HANDLERS] = {
+	[ADD_H] = &&ADD_H_L, [SUB_H] = &&SUB_H_L, [MUL_H] = &&MUL_H_L,
+	[DIV_H] = &&DIV_H_L, [MFHI_H] = &&MFHI_H_L, [MFLO_H] = &&MFLO_H_L,
+	[AND_H] = &&AND_H_L, [BOR_H] = &&BOR_H_L, [NOR_H] = &&NOR_H_L,
+	[XOR_H] = &&XOR_H_L, [SLL_H] = &&SLL_H_L, [SRL_H] = &&SRL_H_L,
+	[JR_H] = &&JR_H_L,
+	[ADDI_H] = &&ADDI_H_L, [ANDI_H] = &&ANDI_H_L, [BORI_H] = &&BORI_H_L,
+	[XORI_H] = &&XORI_H_L,
+	[BEQ_H] = &&BEQ_H_L, [BGEZ_H] = &&BGEZ_H_L, [BGTZ_H] = &&BGTZ_H_L,
+	[BLEZ_H] = &&BLEZ_H_L, [BLTZ_H] = &&BLTZ_H_L, [BNE_H] = &&BNE_H_L,
+	[LBU_H] = &&LBU_H_L, [LW_H] = &&LW_H_L, [SB_H] = &&SB_H_L,
+	[SW_H] = &&SW_H_L,
+	[JMP_H] = &&JMP_H_L, [JAL_H] = &&JAL_H_L,
+	[EXIT_H] = &&EXIT_H_L, [PSTR_H] = &&PSTR_H_L, [PINT_H] = &&PINT_H_L,
+	[PCH_H] = &&PCH_H_L, [RCH_H] = &&RCH_H_L, [STRA_H] = &&STRA_H_L,
+	[NOTR_H] = &&NOTR_H_L,
+	[BAD_FUNC_H] = &&BAD_FUNC_H_L, [BAD_SYSCALL_H] = &&BAD_SYSCALL_H_L,
+	[BAD_OP_H] = &&BAD_OP_H_L, [BAD_TYPE_H] = &&BAD_TYPE_H_L,
+	[PUSH_H] = &&PUSH_H_L, [POP_H] = &&POP_H_L,
+	[LW_PUSH_H] = &&LW_PUSH_H_L,
+	[POP2_ADD_PUSH_H] = &&POP2_ADD_PUSH_H_L,
+	[POP2_SUB_PUSH_H] = &&POP2_SUB_PUSH_H_L,
+	[ADD_LW_H] = &&ADD_LW_H_L, [ADD_SW_H] = &&ADD_SW_H_L
+    };
+    m->threaded_labels = labels;
+    for (unsigned int i = 0; i < m->instructions_loaded; i++) {
+	m->decoded[i].threaded = labels[m->decoded[i].handler];
+    }
+
+    const decoded_instr_t *di;
+    address_type wa;
+
+// go to the handler for the instruction at PC,
+// but take the slow path when tracing or outside the loaded text
+#define DISPATCH()						\
+    do {							\
+	ENGINE_CHECK_EACH();					\
+	wa = m->PC / BYTES_PER_WORD;				\
+	if (m->tracing || wa >= m->instructions_loaded) {	\
+	    goto slow_path;					\
+	}							\
+	di = &m->decoded[wa];					\
+	m->PC = m->PC + BYTES_PER_WORD;				\
+	m->instructions_executed++;				\
+	goto *di->threaded;					\
+    } while (0)
+
+    DISPATCH();
+ slow_path:
+    while (m->running) {
+	ENGINE_CHECK_TRANSFER(); // the slow path always checks
+	step_traced(m, wa);
+	if (!m->running) {
+	    return;
+	}
+	DISPATCH();
+    }
+    return;
+
+#define HANDLER(h) h##_L:
+#define END_HANDLER DISPATCH();
+#define END_TRANSFER_HANDLER ENGINE_CHECK_TRANSFER(); ENGINE_CHECK_LIMITS(); DISPATCH();
+#define TRACING_TURNED_ON() trace_state(m)
+#define ACCOUNT_FOR_FUSED() ADVANCE_PAST_FUSED(di)
+#define MACHINE_STOPPED() return
+#include "machine_handlers.h"
+#undef HANDLER
+#undef END_HANDLER
+#undef END_TRANSFER_HANDLER
+#undef TRACING_TURNED_ON
+#undef ACCOUNT_FOR_FUSED
+#undef MACHINE_STOPPED
+#undef DISPATCH
+}
+#else
+// Execute the loaded program with the portable switch-based dispatch
+static void ENGINE_FN(machine_t *m)
+{
+    while (m->running) {
+	ENGINE_CHECK_EACH();
+	address_type wa = m->PC / BYTES_PER_WORD;
+	if (m->tracing || wa >= m->instructions_loaded) {
+	    ENGINE_CHECK_TRANSFER(); // the slow path always checks
+	    step_traced(m, wa);
+	    continue;
+	}
+	const decoded_instr_t *di = &m->decoded[wa];
+	m->PC = m->PC + BYTES_PER_WORD;
+	m->instructions_executed++;
+	switch (di->handler) {
+#define HANDLER(h) case h:
+#define END_HANDLER break;
+#define END_TRANSFER_HANDLER ENGINE_CHECK_TRANSFER(); ENGINE_CHECK_LIMITS(); break;
+#define TRACING_TURNED_ON() trace_state(m)
+#define ACCOUNT_FOR_FUSED() ADVANCE_PAST_FUSED(di)
+#define MACHINE_STOPPED() return
+#include "machine_handlers.h"
+#undef HANDLER
+#undef END_HANDLER
+#undef END_TRANSFER_HANDLER
+#undef TRACING_TURNED_ON
+#undef ACCOUNT_FOR_FUSED
+#undef MACHINE_STOPPED
+	default:
+	    machine_error(m, "Invalid handler (%d) in the VM's run loop!",
+			  di->handler);
+	    return;
+	}
+    }
+}
+#endif
+
+#undef ENGINE_CHECK_EACH
+#undef ENGINE_CHECK_TRANSFER
+#undef ENGINE_FN
+#undef ENGINE_CHECK_EVERY_INSTR
@@ -0,0 +1,255 @@
+/* $Id$ */
+// The bodies of the VM's instruction handlers.
+// This file is not a normal header: machine.c includes it once for each
+// dispatch engine, after defining HANDLER(h), which starts the code
+// for the handler with id h, END_HANDLER, which ends it,
+// END_TRANSFER_HANDLER, which ends a branch or jump handler instead,
+// TRACING_TURNED_ON(), which is run when a STRA instruction
+// turns tracing on (so the engine can print the state if needed),
+// ACCOUNT_FOR_FUSED(), which is run by each superinstruction's
+// handler to account for the PC increments and instruction counts
+// of all but the first of the di->length instructions it stands for,
+// and MACHINE_STOPPED(), which leaves the engine after a handler
+// has stopped the machine (by exiting or with machine_error).
+// The variable m points to the machine being run,
+// di points to the pre-decoded instruction being executed,
+// and m->PC has already been incremented when a handler starts.
+// A superinstruction's handler does the work of each instruction
+// it stands for, in order.
+
+HANDLER(ADD_H)
+    m->GPR[di->rd] = m->GPR[di->rs] + m->GPR[di->rt];
+END_HANDLER
+HANDLER(SUB_H)
+    m->GPR[di->rd] = m->GPR[di->rs] - m->GPR[di->rt];
+END_HANDLER
+HANDLER(MUL_H)
+    m->hilo_regs.result = m->GPR[di->rs] * m->GPR[di->rt];
+END_HANDLER
+HANDLER(DIV_H)
+    if (m->GPR[di->rt] == 0) {
+	machine_error(m, "Attempt to divide by zero!");
+	MACHINE_STOPPED();
+    }
+    m->hilo_regs.hilo[HI] = m->GPR[di->rs] % m->GPR[di->rt];
+    m->hilo_regs.hilo[LO] = m->GPR[di->rs] / m->GPR[di->rt];
+END_HANDLER
+HANDLER(MFHI_H)
+    m->GPR[di->rd] = m->hilo_regs.hilo[HI];
+END_HANDLER
+HANDLER(MFLO_H)
+    m->GPR[di->rd] = m->hilo_regs.hilo[LO];
+END_HANDLER
+HANDLER(AND_H)
+    m->GPR[di->rd] = m->GPR[di->rs] & m->GPR[di->rt];
+END_HANDLER
+HANDLER(BOR_H)
+    m->GPR[di->rd] = m->GPR[di->rs] | m->GPR[di->rt];
+END_HANDLER
+HANDLER(NOR_H)
+    m->GPR[di->rd] = ~(m->GPR[di->rs] | m->GPR[di->rt]);
+END_HANDLER
+HANDLER(XOR_H)
+    m->GPR[di->rd] = m->GPR[di->rs] ^ m->GPR[di->rt];
+END_HANDLER
+HANDLER(SLL_H)
+    m->GPR[di->rd] = m->GPR[di->rt] << di->shift;
+END_HANDLER
+HANDLER(SRL_H)
+    m->GPR[di->rd] = ((unsigned int)m->GPR[di->rt]) >> di->shift;
+END_HANDLER
+HANDLER(JR_H)
+    m->PC = m->GPR[di->rs];
+END_TRANSFER_HANDLER
+HANDLER(ADDI_H)
+    m->GPR[di->rt] = m->GPR[di->rs] + di->immed;
+END_HANDLER
+HANDLER(ANDI_H)
+    m->GPR[di->rt] = m->GPR[di->rs] & di->immed;
+END_HANDLER
+HANDLER(BORI_H)
+    m->GPR[di->rt] = m->GPR[di->rs] | di->immed;
+END_HANDLER
+HANDLER(XORI_H)
+    m->GPR[di->rt] = m->GPR[di->rs] ^ di->immed;
+END_HANDLER
+HANDLER(BEQ_H)
+    if (m->GPR[di->rs] == m->GPR[di->rt]) {
+	m->PC = di->target;
+    }
+END_TRANSFER_HANDLER
+HANDLER(BGEZ_H)
+    if (m->GPR[di->rs] >= 0) {
+	m->PC = di->target;
+    }
+END_TRANSFER_HANDLER
+HANDLER(BGTZ_H)
+    if (m->GPR[di->rs] > 0) {
+	m->PC = di->target;
+    }
+END_TRANSFER_HANDLER
+HANDLER(BLEZ_H)
+    if (m->GPR[di->rs] <= 0) {
+	m->PC = di->target;
+    }
+END_TRANSFER_HANDLER
+HANDLER(BLTZ_H)
+    if (m->GPR[di->rs] < 0) {
+	m->PC = di->target;
+    }
+END_TRANSFER_HANDLER
+HANDLER(BNE_H)
+    if (m->GPR[di->rs] != m->GPR[di->rt]) {
+	m->PC = di->target;
+    }
+END_TRANSFER_HANDLER
+HANDLER(LBU_H)
+    {
+	address_type ba = m->GPR[di->rs] + di->immed;
+	m->GPR[di->rt] = machine_types_zeroExt(m->memory.bytes[ba]);
+    }
+END_HANDLER
+HANDLER(LW_H)
+    {
+	address_type wa = (m->GPR[di->rs] + di->immed) / BYTES_PER_WORD;
+	m->GPR[di->rt] = m->memory.words[wa];
+    }
+END_HANDLER
+HANDLER(SB_H)
+    {
+	address_type ba = m->GPR[di->rs] + di->immed;
+	m->memory.bytes[ba] = m->GPR[di->rt];
+	note_store(m, ba / BYTES_PER_WORD);
+    }
+END_HANDLER
+HANDLER(SW_H)
+    {
+	address_type wa = (m->GPR[di->rs] + di->immed) / BYTES_PER_WORD;
+	m->memory.words[wa] = m->GPR[di->rt];
+	note_store(m, wa);
+    }
+END_HANDLER
+HANDLER(JMP_H)
+    m->PC = di->target;
+END_TRANSFER_HANDLER
+HANDLER(JAL_H)
+    m->GPR[RA] = m->PC;
+    m->PC = di->target;
+END_TRANSFER_HANDLER
+HANDLER(EXIT_H)
+    output_flush(m);
+    m->running = false;
+    m->exit_status = EXIT_SUCCESS;
+    MACHINE_STOPPED();
+END_HANDLER
+HANDLER(PSTR_H)
+    m->GPR[V0] = output_string(m, (const char *)&m->memory.bytes[m->GPR[A0]]);
+END_HANDLER
+HANDLER(PINT_H)
+    m->GPR[V0] = output_int(m, m->GPR[A0]);
+END_HANDLER
+HANDLER(PCH_H)
+    m->GPR[V0] = output_char(m, m->GPR[A0]);
+END_HANDLER
+HANDLER(RCH_H)
+    output_flush(m); // (reading a tty may flush a line-buffered out)
+    m->GPR[V0] = getc(m->in);
+END_HANDLER
+HANDLER(STRA_H)
+    if (!m->tracing) {
+	m->tracing = true;
+	// (the stores made since tracing stopped were not traced)
+	m->trace_synced = false;
+	TRACING_TURNED_ON();
+    }
+END_HANDLER
+HANDLER(NOTR_H)
+    m->tracing = false;
+END_HANDLER
+HANDLER(BAD_FUNC_H)
+    machine_error(m, "Invalid function code (%d) in machine_execute's register instruction case!",
+		  di->immed);
+    MACHINE_STOPPED();
+END_HANDLER
+HANDLER(BAD_SYSCALL_H)
+    machine_error(m, "Invalid system call type (%d) in machine_execute's syscall instruction case!",
+		  di->immed);
+    MACHINE_STOPPED();
+END_HANDLER
+HANDLER(BAD_OP_H)
+    machine_error(m, "Invalid opcode (%d) in machine_execute's immediate instruction case!",
+		  di->immed);
+    MACHINE_STOPPED();
+END_HANDLER
+HANDLER(BAD_TYPE_H)
+    machine_error(m, "Invalid instruction type (%d) in machine_execute!",
+		  di->immed);
+    MACHINE_STOPPED();
+END_HANDLER
+HANDLER(PUSH_H)
+    ACCOUNT_FOR_FUSED();
+    {
+	m->GPR[SP] = m->GPR[SP] - BYTES_PER_WORD;
+	address_type wa = m->GPR[SP] / BYTES_PER_WORD;
+	m->memory.words[wa] = m->GPR[di->rt];
+	note_store(m, wa);
+    }
+END_HANDLER
+HANDLER(POP_H)
+    ACCOUNT_FOR_FUSED();
+    m->GPR[di->rt] = m->memory.words[m->GPR[SP] / BYTES_PER_WORD];
+    m->GPR[SP] = m->GPR[SP] + BYTES_PER_WORD;
+END_HANDLER
+HANDLER(LW_PUSH_H)
+    ACCOUNT_FOR_FUSED();
+    {
+	address_type wa = (m->GPR[di->rs] + di->immed) / BYTES_PER_WORD;
+	m->GPR[di->rt] = m->memory.words[wa];
+	m->GPR[SP] = m->GPR[SP] - BYTES_PER_WORD;
+	wa = m->GPR[SP] / BYTES_PER_WORD;
+	m->memory.words[wa] = m->GPR[di->rt];
+	note_store(m, wa);
+    }
+END_HANDLER
+HANDLER(POP2_ADD_PUSH_H)
+    ACCOUNT_FOR_FUSED();
+    {
+	m->GPR[di->ra] = m->memory.words[m->GPR[SP] / BYTES_PER_WORD];
+	m->GPR[SP] = m->GPR[SP] + BYTES_PER_WORD;
+	m->GPR[di->rb] = m->memory.words[m->GPR[SP] / BYTES_PER_WORD];
+	m->GPR[SP] = m->GPR[SP] + BYTES_PER_WORD;
+	m->GPR[di->rd] = m->GPR[di->rs] + m->GPR[di->rt];
+	m->GPR[SP] = m->GPR[SP] - BYTES_PER_WORD;
+	address_type wa = m->GPR[SP] / BYTES_PER_WORD;
+	m->memory.words[wa] = m->GPR[di->rd];
+	note_store(m, wa);
+    }
+END_HANDLER
+HANDLER(POP2_SUB_PUSH_H)
+    ACCOUNT_FOR_FUSED();
+    {
+	m->GPR[di->ra] = m->memory.words[m->GPR[SP] / BYTES_PER_WORD];
+	m->GPR[SP] = m->GPR[SP] + BYTES_PER_WORD;
+	m->GPR[di->rb] = m->memory.words[m->GPR[SP] / BYTES_PER_WORD];
+	m->GPR[SP] = m->GPR[SP] + BYTES_PER_WORD;
+	m->GPR[di->rd] = m->GPR[di->rs] - m->GPR[di->rt];
+	m->GPR[SP] = m->GPR[SP] - BYTES_PER_WORD;
+	address_type wa = m->GPR[SP] / BYTES_PER_WORD;
+	m->memory.words[wa] = m->GPR[di->rd];
+	note_store(m, wa);
+    }
+END_HANDLER
+HANDLER(ADD_LW_H)
+    ACCOUNT_FOR_FUSED();
+    m->GPR[di->rd] = m->GPR[di->rs] + m->GPR[di->rt];
+    m->GPR[di->rb] = m->memory.words[(m->GPR[di->rd] + di->immed) / BYTES_PER_WORD];
+END_HANDLER
+HANDLER(ADD_SW_H)
+    ACCOUNT_FOR_FUSED();
+    m->GPR[di->rd] = m->GPR[di->rs] + m->GPR[di->rt];
+    {
+	address_type wa = (m->GPR[di->rd] + di->immed) / BYTES_PER_WORD;
+	m->memory.words[wa] = m->GPR[di->rb];
+	note_store(m, wa);
+    }
+END_HANDLER
@@ -1,17 +1,204 @@
 /* $Id: machine_main.c,v 1.5 2023/11/14 18:25:32 leavens Exp $ */
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <time.h>
 #include "bof.h"
 #include "machine.h"
+#include "perf_counters.h"
 #include "utilities.h"
 
 /* Print a usage message on stderr and exit with exit code 1. */
 static void usage(const char *cmdname)
 {
-    fprintf(stderr, "Usage: %s file.bof\n", cmdname);
-    fprintf(stderr, "   or: %s -p file.bof\n", cmdname);
-    bail_with_error("   or: %s -t file.bof", cmdname);
+    fprintf(stderr, "Usage: %s [-s] [-H] [-b | -B | -j | -P] [-A] [-O | --paranoid] [-T] [--max-instrs N] [--max-ms T] [--snapshot-at N] (file.bof | file.snap)\n", cmdname);
+    fprintf(stderr, "   or: %s -p (file.bof | file.snap)\n", cmdname);
+    fprintf(stderr, "   or: %s [-s] [-H] [-b | -B | -j | -P] [-A] [-O | --paranoid] [-T] -t (file.bof | file.snap)\n", cmdname);
+    fprintf(stderr, "(-s prints execution statistics on stderr at exit,\n");
+    fprintf(stderr, " -H counts the host's cycles, instructions, branches,\n");
+    fprintf(stderr, "    branch misses, and cache misses while the program runs,\n");
+    fprintf(stderr, "    printing them (and each per instruction) on stderr at exit\n");
+    fprintf(stderr, "    (or just the time, if the host's counters are not available),\n");
+    fprintf(stderr, " -b runs the program a basic block at a time,\n");
+    fprintf(stderr, " -B does too, printing each block's execution count at exit,\n");
+    fprintf(stderr, " -j also compiles hot blocks to native code, implying -O,\n");
+    fprintf(stderr, " -P profiles the program, printing a report on stderr at exit\n");
+    fprintf(stderr, "    and writing it in CSV form to file.prof.csv\n");
+    fprintf(stderr, "    and its counts for each stack of calls, for flamegraph.pl,\n");
+    fprintf(stderr, "    to file.prof.folded\n");
+    fprintf(stderr, "    (with a report by PL/0 statement and line, if the compiler\n");
+    fprintf(stderr, "    wrote the map file.map, with -g),\n");
+    fprintf(stderr, " -A analyzes the program's memory traffic and branches,\n");
+    fprintf(stderr, "    feeding its loads and stores to a simulated cache\n");
+    fprintf(stderr, "    (set with --cache SIZE,LINE,WAYS, in bytes, bytes, and lines;\n");
+    fprintf(stderr, "    by default 4096,16,2) and its branches to a simulated\n");
+    fprintf(stderr, "    branch predictor (set with --predictor 2bit,BITS\n");
+    fprintf(stderr, "    or --predictor gshare,BITS, for 2 to the BITS counters;\n");
+    fprintf(stderr, "    by default 2bit,10), and printing their miss rates\n");
+    fprintf(stderr, "    for each instruction on stderr at exit,\n");
+    fprintf(stderr, " -T writes the tracing output (with -t, or after a STRA instruction)\n");
+    fprintf(stderr, "    in a compact binary form to file.trace, instead of printing it\n");
+    fprintf(stderr, "    (vm-trace prints it as text, with the program's output),\n");
+    fprintf(stderr, " --max-instrs stops the program after it executes N instructions,\n");
+    fprintf(stderr, " --max-ms stops it after it runs for T milliseconds\n");
+    fprintf(stderr, "    (with the exit status %d and a summary on stderr),\n",
+	    MACHINE_LIMIT_EXCEEDED);
+    fprintf(stderr, " --snapshot-at runs the first N instructions, writes a snapshot\n");
+    fprintf(stderr, "    of the machine to file.snap, and goes on from there\n");
+    fprintf(stderr, "    (the other options only apply after the snapshot),\n");
+    fprintf(stderr, " file.snap runs the program from that snapshot instead of its start,\n");
+    fprintf(stderr, " -O only checks the VM's invariant after branches and jumps,\n");
+    bail_with_error(" --paranoid checks it before every instruction, the default)");
+}
+
+// the machine that runs the program
+static machine_t *vm;
+
+// Return the cache shape given by the argument arg of --cache
+// (exiting with an error message if it is not one that can be simulated)
+static cache_config_t parse_cache(const char *arg)
+{
+    cache_config_t c;
+    int end = 0;
+    if (sscanf(arg, "%u,%u,%u%n", &c.size, &c.line_size, &c.ways, &end) != 3
+	|| arg[end] != '\0' || !analysis_cache_config_okay(c)) {
+	bail_with_error("The cache given with --cache must be SIZE,LINE,WAYS,"
+			" all powers of 2, with LINE at least %d"
+			" and SIZE at least LINE*WAYS, not %s!",
+			BYTES_PER_WORD, arg);
+    }
+    return c;
+}
+
+// Return the branch predictor shape given by the argument arg of --predictor
+// (exiting with an error message if it is not one that can be simulated)
+static predictor_config_t parse_predictor(const char *arg)
+{
+    predictor_config_t p;
+    int end = 0;
+    if (sscanf(arg, "2bit,%u%n", &p.index_bits, &end) == 1
+	&& arg[end] == '\0') {
+	p.kind = two_bit_predictor;
+    } else if (sscanf(arg, "gshare,%u%n", &p.index_bits, &end) == 1
+	       && arg[end] == '\0') {
+	p.kind = gshare_predictor;
+    } else {
+	end = 0;
+    }
+    if (end == 0 || !analysis_predictor_config_okay(p)) {
+	bail_with_error("The predictor given with --predictor must be"
+			" 2bit,BITS or gshare,BITS, with BITS at most %d,"
+			" not %s!", MAX_PREDICTOR_INDEX_BITS, arg);
+    }
+    return p;
+}
+
+// the time at which the program started running (for -s)
+static struct timespec start_time;
+
+// Print the number of instructions executed, the elapsed time,
+// and the instructions per second on stderr
+static void print_statistics()
+{
+    struct timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    double secs = (end_time.tv_sec - start_time.tv_sec)
+	+ (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+    unsigned long count = machine_instruction_count(vm);
+    fflush(stdout);
+    fprintf(stderr, "%s dispatch: %lu instructions in %.6f seconds",
+	    machine_dispatch_name(vm), count, secs);
+    if (secs > 0) {
+	fprintf(stderr, " (%.0f instructions/second)", count / secs);
+    }
+    newline(stderr);
+}
+
+// the host's counters (for -H)
+static perf_counters_t host_counters;
+
+// Stop the host's counters and print them, for each instruction
+// executed, on stderr
+static void print_host_counters()
+{
+    perf_counters_stop(&host_counters);
+    fflush(stdout);
+    perf_counters_print(&host_counters, machine_instruction_count(vm),
+			stderr);
+}
+
+// Print the execution count of each basic block on stderr
+static void print_block_counts()
+{
+    fflush(stdout);
+    machine_print_block_counts(vm, stderr);
+}
+
+// Print a report of the analysis of the program's memory accesses
+// and branches on stderr
+static void print_analysis()
+{
+    fflush(stdout);
+    machine_print_analysis(vm, stderr);
+}
+
+// the names of the files for the profile in CSV form
+// and in folded-stack form, and of the program's source map (for -P)
+static char *profile_csv_name;
+static char *profile_folded_name;
+static char *source_map_name;
+
+// Print a report of the program's profile on stderr in terms of
+// its source, whose map is map
+static void print_source_profile(source_map_t *map)
+{
+    // the source file is in the same directory as the map
+    const char *slash = strrchr(source_map_name, '/');
+    int dir_len = (slash == NULL) ? 0 : slash - source_map_name + 1;
+    char source_name[dir_len + strlen(map->source_name) + 1];
+    sprintf(source_name, "%.*s%s", dir_len, source_map_name,
+	    map->source_name);
+    FILE *source = fopen(source_name, "r");
+    machine_print_source_profile(vm, map, source, stderr);
+    if (source != NULL) {
+	fclose(source);
+    }
+}
+
+// Return the file named name, opened for writing
+// (exiting with an error message if that fails)
+static FILE *open_for_writing(const char *name)
+{
+    FILE *f = fopen(name, "w");
+    if (f == NULL) {
+	bail_with_error("Cannot open %s for writing!", name);
+    }
+    return f;
+}
+
+// Print a report of the program's profile on stderr
+// (and one in terms of its source, if it has a source map),
+// and write the profile in CSV form to the file profile_csv_name
+// and in folded-stack form to the file profile_folded_name
+static void print_profile()
+{
+    fflush(stdout);
+    machine_print_profile(vm, stderr);
+    source_map_t *map = source_map_read(source_map_name);
+    if (map != NULL) {
+	print_source_profile(map);
+    }
+    FILE *csv = open_for_writing(profile_csv_name);
+    machine_write_profile_csv(vm, csv);
+    fclose(csv);
+    FILE *folded = open_for_writing(profile_folded_name);
+    machine_write_profile_folded(vm, map, folded);
+    fclose(folded);
+    if (map != NULL) {
+	source_map_destroy(map);
+    }
 }
 
 // Run the VM on the .bof file name given in argv[1]
@@ -23,14 +210,72 @@ int main(int argc, char *argv[])
 
     bool print_program = false;
     bool should_trace = false;
-    if (argc == 2 && strcmp(argv[0], "-p") == 0) {
-	print_program = true;
-	argc--;
-	argv++;
-    }
-
-    if (argc == 2 && strcmp(argv[0], "-t") == 0) {
-	should_trace = true;
+    bool binary_trace = false;
+    bool print_stats = false;
+    bool count_host = false;
+    bool print_blocks = false;
+    bool profiling = false;
+    bool analyzing = false;
+    cache_config_t cache = DEFAULT_CACHE_CONFIG;
+    predictor_config_t predictor = DEFAULT_PREDICTOR_CONFIG;
+    bool use_blocks = false;
+    unsigned long max_instrs = 0;
+    unsigned long max_ms = 0;
+    unsigned long snapshot_at = 0;
+    vm = machine_create();
+    while (argc > 1 && argv[0][0] == '-') {
+	if (strcmp(argv[0], "-p") == 0) {
+	    print_program = true;
+	} else if (strcmp(argv[0], "-t") == 0) {
+	    should_trace = true;
+	} else if (strcmp(argv[0], "--max-instrs") == 0 && argc > 2) {
+	    max_instrs = parse_count(argv[0], argv[1]);
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "--max-ms") == 0 && argc > 2) {
+	    max_ms = parse_count(argv[0], argv[1]);
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "-A") == 0) {
+	    analyzing = true;
+	} else if (strcmp(argv[0], "--cache") == 0 && argc > 2) {
+	    cache = parse_cache(argv[1]);
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "--predictor") == 0 && argc > 2) {
+	    predictor = parse_predictor(argv[1]);
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "--snapshot-at") == 0 && argc > 2) {
+	    snapshot_at = parse_count(argv[0], argv[1]);
+	    argc--;
+	    argv++;
+	} else if (strcmp(argv[0], "-T") == 0) {
+	    binary_trace = true;
+	} else if (strcmp(argv[0], "-s") == 0) {
+	    print_stats = true;
+	} else if (strcmp(argv[0], "-H") == 0) {
+	    count_host = true;
+	} else if (strcmp(argv[0], "-b") == 0) {
+	    machine_set_block_mode(vm, true);
+	    use_blocks = true;
+	} else if (strcmp(argv[0], "-B") == 0) {
+	    machine_set_block_mode(vm, true);
+	    use_blocks = true;
+	    print_blocks = true;
+	} else if (strcmp(argv[0], "-j") == 0) {
+	    machine_set_jit_mode(vm, true);
+	    use_blocks = true;
+	} else if (strcmp(argv[0], "-P") == 0) {
+	    machine_set_profile_mode(vm, true);
+	    profiling = true;
+	} else if (strcmp(argv[0], "-O") == 0) {
+	    machine_set_check_mode(vm, release_checking);
+	} else if (strcmp(argv[0], "--paranoid") == 0) {
+	    machine_set_check_mode(vm, paranoid_checking);
+	} else {
+	    usage(cmdname);
+	}
 	argc--;
 	argv++;
     }
@@ -38,30 +283,107 @@ int main(int argc, char *argv[])
     if (print_program && should_trace) {
 	bail_with_error("Cannot both print the program (with -p) and trace it (with -t)!");
     }
+    if (profiling && use_blocks) {
+	bail_with_error("Cannot both profile the program (with -P) and run it a block at a time (with -b, -B, or -j)!");
+    }
+    if (analyzing && use_blocks) {
+	bail_with_error("Cannot both analyze the program (with -A) and run it a block at a time (with -b, -B, or -j)!");
+    }
 
     // now there should be exactly 1 file argument
     if (argc != 1 || argv[0][0] == '-') {
 	usage(cmdname);
     }
 
-    char *suffix = strchr(argv[0], '.');
-    if (suffix == NULL || strcmp(suffix, ".bof") != 0) {
+    char *suffix = strrchr(argv[0], '.');
+    if (suffix == NULL
+	|| (strcmp(suffix, ".bof") != 0 && strcmp(suffix, ".snap") != 0)) {
 	usage(cmdname);
     }
+    // the length of the file's name without its suffix
+    int len = suffix - argv[0];
 
-    BOFFILE bf = bof_read_open(argv[0]);
-
-    machine_load(bf);
+    machine_set_limits(vm, max_instrs, max_ms);
+    machine_set_analysis_mode(vm, analyzing, cache, predictor);
+    if (strcmp(suffix, ".snap") == 0) {
+	machine_restore(vm, argv[0]);
+    } else {
+	BOFFILE bf = bof_read_open(argv[0]);
+	machine_load(vm, bf);
+    }
 
     // if printing, don't run the program
     if (print_program) {
-	machine_print_loaded_program(stdout);
+	machine_print_loaded_program(vm, stdout);
 	return EXIT_SUCCESS;
     }
-    
-    machine_run(should_trace);
 
-    // the following should never execute,
-    // as the exit system call will call exit(0);
-    return EXIT_SUCCESS;
+    if (snapshot_at > 0) {
+	// file.bof's snapshot goes in file.snap
+	char snapshot_name[len + strlen(".snap") + 1];
+	sprintf(snapshot_name, "%.*s.snap", len, argv[0]);
+	for (unsigned long i = 0; i < snapshot_at; i++) {
+	    if (!machine_step(vm)) {
+		bail_with_error("The program stopped after %lu instructions,"
+				" before %s could be written!",
+				i + 1, snapshot_name);
+	    }
+	}
+	machine_snapshot(vm, snapshot_name);
+    }
+    if (binary_trace) {
+	// file.bof's binary trace goes in file.trace
+	char trace_name[len + strlen(".trace") + 1];
+	sprintf(trace_name, "%.*s.trace", len, argv[0]);
+	FILE *trace = fopen(trace_name, "wb");
+	if (trace == NULL) {
+	    bail_with_error("Cannot open %s for writing!", trace_name);
+	}
+	machine_set_binary_trace(vm, trace);
+    }
+    if (print_blocks) {
+	atexit(print_block_counts);
+    }
+    if (profiling) {
+	// file.bof's profile goes in file.prof.csv and file.prof.folded,
+	// and its source map is in file.map
+	profile_csv_name = (char *)malloc(len + strlen(".prof.csv") + 1);
+	profile_folded_name = (char *)malloc(len + strlen(".prof.folded") + 1);
+	source_map_name = (char *)malloc(len + strlen(".map") + 1);
+	if (profile_csv_name == NULL || profile_folded_name == NULL
+	    || source_map_name == NULL) {
+	    bail_with_error("Cannot allocate space for a file name!");
+	}
+	sprintf(profile_csv_name, "%.*s.prof.csv", len, argv[0]);
+	sprintf(profile_folded_name, "%.*s.prof.folded", len, argv[0]);
+	sprintf(source_map_name, "%.*s.map", len, argv[0]);
+	atexit(print_profile);
+    }
+    if (analyzing) {
+	atexit(print_analysis);
+    }
+    if (print_stats) {
+	// (from an exit handler, which is not run if the VM aborts)
+	atexit(print_statistics);
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+    }
+    if (count_host) {
+	// (last, so the counters only count running the program)
+	atexit(print_host_counters);
+	perf_counters_start(&host_counters);
+    }
+    
+    int status = machine_run(vm, should_trace);
+    if (status == MACHINE_INVARIANT_FAILURE) {
+	// (the profile is most useful when the program went wrong)
+	if (profiling) {
+	    print_profile();
+	}
+	if (analyzing) {
+	    print_analysis();
+	}
+	// as for a failed assertion
+	abort();
+    }
+    exit(status);
 }
@@ -0,0 +1,42 @@
+	# $Id$
+	# prints with each print system call in a loop, and prints what
+	# each call returns, tracing one of the iterations, so that the
+	# VM's buffered output can be compared with output printed directly
+	.text start
+start:	ADDI $0, $t0, 40     # $t0 counts down the iterations
+loop:	ADDI $0, $t1, 3
+	BNE $t0, $t1, 1      # trace the iteration where $t0 is 3
+	STRA
+	ADDI $0, $t1, 2
+	BNE $t0, $t1, 1      # and stop tracing when $t0 is 2
+	NOTR
+	ADDI $0, $t1, -50    # print ($t0 - 20) * -50
+	ADDI $t0, $t2, -20
+	MUL $t1, $t2
+	MFLO $a0
+	PINT
+	ADD $0, $v0, $a0     # print the number of characters printed
+	PINT
+	ADDI $0, $a0, 32     # print a space
+	PCH
+	ADD $0, $v0, $a0     # print what printing the space returned
+	PINT
+	ADDI $gp, $a0, 0     # print the string in the global data
+	PSTR
+	ADD $0, $v0, $a0     # print its length
+	PINT
+	ADDI $0, $a0, 10     # print a newline
+	PCH
+	ADDI $t0, $t0, -1
+	BGTZ $t0, -25        # back to loop while $t0 > 0
+	ADDI $0, $a0, 1      # print the most negative int
+	SLL $a0, $a0, 31
+	PINT
+	ADDI $0, $a0, 10
+	PCH
+	EXIT
+	.data 1024
+	WORD greeting = 560556064  # the characters " hi!"
+	WORD end = 0
+	.stack 4096
+	.end
@@ -0,0 +1,159 @@
+/* $Id$ */
+// (for syscall)
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "perf_counters.h"
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+// the names of the events, as printed
+static const char *event_names[NUM_PERF_EVENTS] = {
+    [perf_cycles] = "cycles", [perf_instructions] = "instructions",
+    [perf_branches] = "branches", [perf_branch_misses] = "branch misses",
+    [perf_cache_misses] = "cache misses"
+};
+
+#ifdef __linux__
+// the perf_event_open configuration of each event
+static const unsigned long long event_configs[NUM_PERF_EVENTS] = {
+    [perf_cycles] = PERF_COUNT_HW_CPU_CYCLES,
+    [perf_instructions] = PERF_COUNT_HW_INSTRUCTIONS,
+    [perf_branches] = PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+    [perf_branch_misses] = PERF_COUNT_HW_BRANCH_MISSES,
+    [perf_cache_misses] = PERF_COUNT_HW_CACHE_MISSES
+};
+
+// Return a file descriptor for a new, disabled counter of the event e
+// in this process (only in user mode, which is all that
+// an unprivileged process may count), or -1 if that is not available
+static int open_counter(perf_event_type e)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = event_configs[e];
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // (so counts can be scaled if the counter was not always running)
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+	| PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+// Open the counters of pc (those that are available)
+// and start counting the events of this process,
+// and the time, from now on
+void perf_counters_start(perf_counters_t *pc)
+{
+    pc->unavailable = NULL;
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+	pc->counts[e] = 0;
+#ifdef __linux__
+	pc->fds[e] = open_counter(e);
+	if (pc->fds[e] < 0 && pc->unavailable == NULL) {
+	    pc->unavailable = strerror(errno);
+	}
+#else
+	pc->fds[e] = -1;
+	pc->unavailable = "perf_event_open is only on Linux";
+#endif
+    }
+    errno = 0; // (the VM's error messages report errno)
+    clock_gettime(CLOCK_MONOTONIC, &pc->start_time);
+#ifdef __linux__
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+	if (pc->fds[e] >= 0) {
+	    ioctl(pc->fds[e], PERF_EVENT_IOC_RESET, 0);
+	    ioctl(pc->fds[e], PERF_EVENT_IOC_ENABLE, 0);
+	}
+    }
+#endif
+}
+
+// Stop the counters of pc, reading their counts, and close them
+void perf_counters_stop(perf_counters_t *pc)
+{
+#ifdef __linux__
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+	if (pc->fds[e] >= 0) {
+	    ioctl(pc->fds[e], PERF_EVENT_IOC_DISABLE, 0);
+	}
+    }
+#endif
+    struct timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    pc->secs = (end_time.tv_sec - pc->start_time.tv_sec)
+	+ (end_time.tv_nsec - pc->start_time.tv_nsec) / 1e9;
+#ifdef __linux__
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+	if (pc->fds[e] < 0) {
+	    continue;
+	}
+	// the count, the time enabled, and the time running
+	unsigned long long values[3];
+	if (read(pc->fds[e], values, sizeof(values)) == sizeof(values)
+	    && values[2] > 0) {
+	    // (scaled up if the counter was multiplexed with others)
+	    pc->counts[e] = (unsigned long long)
+		((double)values[0] * values[1] / values[2]);
+	}
+	close(pc->fds[e]);
+	pc->fds[e] = -1;
+    }
+#endif
+}
+
+// Return true if any of pc's counters was available
+static bool any_counted(perf_counters_t *pc)
+{
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+	if (pc->counts[e] != 0) {
+	    return true;
+	}
+    }
+    return false;
+}
+
+// Requires: pc has stopped
+// Print the counts of pc to out, both in total and for each
+// of the given number of SRM instructions executed
+// (or, if no counter was available, just the time taken)
+void perf_counters_print(perf_counters_t *pc,
+			 unsigned long instructions, FILE *out)
+{
+    // (so no division is by zero)
+    double per = (instructions == 0) ? 1.0 : (double)instructions;
+    if (!any_counted(pc)) {
+	fprintf(out, "host counters are not available (%s),"
+		" so only the time was measured:\n",
+		(pc->unavailable == NULL) ? "no events counted"
+		: pc->unavailable);
+	fprintf(out, "%lu SRM instructions in %.6f seconds"
+		" (%.2f nanoseconds per instruction)\n",
+		instructions, pc->secs, pc->secs * 1e9 / per);
+	return;
+    }
+    fprintf(out, "host counters for %lu SRM instructions in %.6f seconds:\n",
+	    instructions, pc->secs);
+    fprintf(out, "%-16s %16s %16s\n", "event", "count",
+	    "per instruction");
+    for (int e = 0; e < NUM_PERF_EVENTS; e++) {
+	fprintf(out, "%-16s %16llu %16.4f\n", event_names[e],
+		pc->counts[e], pc->counts[e] / per);
+    }
+    if (pc->counts[perf_branches] != 0) {
+	fprintf(out, "branch-miss rate: %.2f%% of host branches\n",
+		100.0 * pc->counts[perf_branch_misses]
+		/ pc->counts[perf_branches]);
+    }
+}
@@ -0,0 +1,52 @@
+/* $Id$ */
+// Counting the host's hardware events (with Linux's perf_event_open)
+// while the VM runs a program, to judge how well the VM itself runs:
+// e.g., how many host cycles each SRM instruction takes,
+// and how often the host mispredicts the branches of the dispatch code.
+// Where the counters are not available (e.g., on other systems,
+// or in virtual machines that do not expose them),
+// only the elapsed time is measured, with clock_gettime.
+#ifndef _PERF_COUNTERS_H
+#define _PERF_COUNTERS_H
+#include <stdio.h>
+#include <stdbool.h>
+#include <time.h>
+
+// the host events that are counted
+typedef enum {
+    perf_cycles, perf_instructions, perf_branches, perf_branch_misses,
+    perf_cache_misses
+} perf_event_type;
+
+#define NUM_PERF_EVENTS 5
+
+// the counters of one measurement
+typedef struct {
+    // the file descriptor of each event's counter (-1 if it is not
+    // available), and its count, once the measurement has stopped
+    int fds[NUM_PERF_EVENTS];
+    unsigned long long counts[NUM_PERF_EVENTS];
+    // why the first counter that is not available is not (or NULL)
+    const char *unavailable;
+    // the time at which the measurement started,
+    // and the number of seconds it took, once it has stopped
+    struct timespec start_time;
+    double secs;
+} perf_counters_t;
+
+// Open the counters of pc (those that are available)
+// and start counting the events of this process,
+// and the time, from now on
+extern void perf_counters_start(perf_counters_t *pc);
+
+// Stop the counters of pc, reading their counts, and close them
+extern void perf_counters_stop(perf_counters_t *pc);
+
+// Requires: pc has stopped
+// Print the counts of pc to out, both in total and for each
+// of the given number of SRM instructions executed
+// (or, if no counter was available, just the time taken)
+extern void perf_counters_print(perf_counters_t *pc,
+				unsigned long instructions, FILE *out);
+
+#endif
@@ -0,0 +1,380 @@
+/* $Id$ */
+// (for getline, used to read source files)
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include "profile.h"
+#include "machine_types.h"
+#include "utilities.h"
+
+// the number of frames the shadow call stack first has room for
+#define INITIAL_STACK_SIZE 64
+
+// Return a new call tree node for a call to callee
+// (with no children), whose parent is parent
+static call_node_t *make_call_node(address_type callee, call_node_t *parent)
+{
+    call_node_t *n = (call_node_t *)malloc(sizeof(call_node_t));
+    if (n == NULL) {
+	bail_with_error("Cannot allocate space for a call tree!");
+    }
+    n->callee = callee;
+    n->count = 0;
+    n->parent = parent;
+    n->first_child = NULL;
+    n->next_sibling = NULL;
+    return n;
+}
+
+// Free the call tree node n and all of its descendants
+static void free_call_tree(call_node_t *n)
+{
+    while (n != NULL) {
+	call_node_t *next = n->next_sibling;
+	free_call_tree(n->first_child);
+	free(n);
+	n = next;
+    }
+}
+
+// Return a new profile, with all counts 0,
+// of a program with count words of text that starts at start_address
+profile_t *profile_create(unsigned int count, address_type start_address)
+{
+    profile_t *p = (profile_t *)calloc(1, sizeof(profile_t));
+    // (one more entry than needed, so an empty program allocates some)
+    unsigned long *executions
+	= (unsigned long *)calloc(count + 1, sizeof(unsigned long));
+    unsigned long *taken
+	= (unsigned long *)calloc(count + 1, sizeof(unsigned long));
+    unsigned long *not_taken
+	= (unsigned long *)calloc(count + 1, sizeof(unsigned long));
+    if (p == NULL || executions == NULL || taken == NULL || not_taken == NULL) {
+	bail_with_error("Cannot allocate space for a profile!");
+    }
+    p->program_words = count;
+    p->executions = executions;
+    p->taken = taken;
+    p->not_taken = not_taken;
+    p->call_root = make_call_node(start_address, NULL);
+    p->stack = (call_frame_t *)
+	malloc(INITIAL_STACK_SIZE * sizeof(call_frame_t));
+    if (p->stack == NULL) {
+	bail_with_error("Cannot allocate space for a shadow call stack!");
+    }
+    p->stack_depth = 0;
+    p->stack_size = INITIAL_STACK_SIZE;
+    p->current = p->call_root;
+    return p;
+}
+
+// Free the profile p
+void profile_destroy(profile_t *p)
+{
+    free(p->executions);
+    free(p->taken);
+    free(p->not_taken);
+    free_call_tree(p->call_root);
+    free(p->stack);
+    free(p);
+}
+
+// Record in p that a JAL has called the procedure at byte address target,
+// which will return to return_address
+void profile_call(profile_t *p, address_type target,
+		  address_type return_address)
+{
+    call_node_t *n = p->current->first_child;
+    call_node_t *last = NULL;
+    while (n != NULL && n->callee != target) {
+	last = n;
+	n = n->next_sibling;
+    }
+    if (n == NULL) {
+	n = make_call_node(target, p->current);
+	if (last == NULL) {
+	    p->current->first_child = n;
+	} else {
+	    last->next_sibling = n;
+	}
+    }
+    if (p->stack_depth == p->stack_size) {
+	p->stack_size = 2 * p->stack_size;
+	p->stack = (call_frame_t *)
+	    realloc(p->stack, p->stack_size * sizeof(call_frame_t));
+	if (p->stack == NULL) {
+	    bail_with_error("Cannot allocate space for a shadow call stack!");
+	}
+    }
+    p->stack[p->stack_depth].node = n;
+    p->stack[p->stack_depth].return_address = return_address;
+    p->stack_depth++;
+    p->current = n;
+}
+
+// Record in p that a JR has jumped to byte address target, which returns
+// from the innermost call on the shadow call stack that returns there
+// (if any; otherwise the JR is not a return)
+void profile_jump_register(profile_t *p, address_type target)
+{
+    unsigned int depth = p->stack_depth;
+    while (depth > 0 && p->stack[depth - 1].return_address != target) {
+	depth--;
+    }
+    if (depth == 0) {
+	return;
+    }
+    // pop the frames down to and including the one returned from
+    p->stack_depth = depth - 1;
+    p->current = p->stack[depth - 1].node->parent;
+}
+
+// something counted in a profile (an instruction or a kind of instruction),
+// for sorting by count
+typedef struct {
+    unsigned int index;
+    unsigned long count;
+} counted_t;
+
+// Return a negative number, 0, or a positive number as the counted_t
+// pointed to by p should come before, is the same as, or should come after
+// the one pointed to by q: those with larger counts come first,
+// and those with equal counts are in order of their indexes
+static int compare_counted(const void *p, const void *q)
+{
+    const counted_t *a = (const counted_t *)p;
+    const counted_t *b = (const counted_t *)q;
+    if (a->count != b->count) {
+	return (a->count > b->count) ? -1 : 1;
+    }
+    return (a->index > b->index) - (a->index < b->index);
+}
+
+// Return the percentage that count is of total
+static double percent(unsigned long count, unsigned long total)
+{
+    return (total == 0) ? 0.0 : (100.0 * count) / total;
+}
+
+// Requires: instrs has p->program_words elements
+// Print a report of p to out, for the program whose text is instrs:
+// the executed instructions, from the most executed to the least,
+// with the outcomes of conditional branches,
+// then the number of executions of each kind of instruction
+void profile_print_report(profile_t *p, const bin_instr_t *instrs, FILE *out)
+{
+    counted_t *sorted = (counted_t *)
+	malloc((p->program_words + NUM_HANDLERS) * sizeof(counted_t));
+    if (sorted == NULL) {
+	bail_with_error("Cannot allocate space to sort a profile!");
+    }
+
+    unsigned long total = 0;
+    unsigned int num_executed = 0;
+    for (unsigned int wa = 0; wa < p->program_words; wa++) {
+	if (p->executions[wa] > 0) {
+	    sorted[num_executed].index = wa;
+	    sorted[num_executed].count = p->executions[wa];
+	    num_executed++;
+	    total += p->executions[wa];
+	}
+    }
+    qsort(sorted, num_executed, sizeof(counted_t), compare_counted);
+    fprintf(out, "Profile: %lu instructions executed, by %u of %u instructions:\n",
+	    total, num_executed, p->program_words);
+    fprintf(out, "%8s %12s %7s %10s %10s  %s\n",
+	    "addr", "count", "%", "taken", "not taken", "instruction");
+    for (unsigned int i = 0; i < num_executed; i++) {
+	unsigned int wa = sorted[i].index;
+	fprintf(out, "%8u %12lu %7.2f ", wa * BYTES_PER_WORD,
+		p->executions[wa], percent(p->executions[wa], total));
+	if (p->taken[wa] > 0 || p->not_taken[wa] > 0) {
+	    fprintf(out, "%10lu %10lu", p->taken[wa], p->not_taken[wa]);
+	} else {
+	    fprintf(out, "%10s %10s", "", "");
+	}
+	fprintf(out, "  %s\n", instruction_assembly_form(instrs[wa]));
+    }
+
+    unsigned int num_kinds = 0;
+    for (unsigned int h = 0; h < NUM_HANDLERS; h++) {
+	if (p->handler_counts[h] > 0) {
+	    sorted[num_kinds].index = h;
+	    sorted[num_kinds].count = p->handler_counts[h];
+	    num_kinds++;
+	}
+    }
+    qsort(sorted, num_kinds, sizeof(counted_t), compare_counted);
+    fprintf(out, "Executions by kind of instruction:\n");
+    fprintf(out, "%-24s %12s %7s\n", "instruction", "count", "%");
+    for (unsigned int i = 0; i < num_kinds; i++) {
+	fprintf(out, "%-24s %12lu %7.2f\n",
+		decode_handler_name(sorted[i].index), sorted[i].count,
+		percent(sorted[i].count, total));
+    }
+    free(sorted);
+}
+
+// Requires: instrs has p->program_words elements
+// Write p to out in CSV form, for the program whose text is instrs,
+// with a heading line and then one line per word of text, in order:
+// address,count,instruction,taken,not_taken
+// (where the last two are empty for instructions that are not
+// conditional branches)
+void profile_write_csv(profile_t *p, const bin_instr_t *instrs, FILE *out)
+{
+    fprintf(out, "address,count,instruction,taken,not_taken\n");
+    for (unsigned int wa = 0; wa < p->program_words; wa++) {
+	// (assembly forms contain commas, but no double quotes)
+	fprintf(out, "%u,%lu,\"%s\",", wa * BYTES_PER_WORD, p->executions[wa],
+		instruction_assembly_form(instrs[wa]));
+	if (p->taken[wa] > 0 || p->not_taken[wa] > 0) {
+	    fprintf(out, "%lu,%lu\n", p->taken[wa], p->not_taken[wa]);
+	} else {
+	    fprintf(out, ",\n");
+	}
+    }
+}
+
+// Requires: map is the source map of the program profiled in p
+// Print a report of p in terms of the program's source to out:
+// the number of instructions executed for each statement,
+// from the most to the least, then the source file (read from source,
+// unless that is NULL) with the number executed for each line.
+// (The instructions of a statement exclude those of
+// the statements inside it.)
+void profile_print_source_report(profile_t *p, source_map_t *map,
+				 FILE *source, FILE *out)
+{
+    // the counts of each statement (with stmt_counts[0] counting
+    // the instructions that are not part of any statement),
+    // and of each line (with room for line 0)
+    unsigned int max_line = 0;
+    for (unsigned int i = 1; i <= map->num_stmts; i++) {
+	max_line = MAX(max_line, map->stmts[i].line);
+    }
+    unsigned long *stmt_counts = (unsigned long *)
+	calloc(map->num_stmts + 1, sizeof(unsigned long));
+    unsigned long *line_counts = (unsigned long *)
+	calloc(max_line + 1, sizeof(unsigned long));
+    counted_t *sorted = (counted_t *)
+	malloc((map->num_stmts + 1) * sizeof(counted_t));
+    if (stmt_counts == NULL || line_counts == NULL || sorted == NULL) {
+	bail_with_error("Cannot allocate space for a profile by statement!");
+    }
+
+    if (map->num_instrs != p->program_words) {
+	fprintf(out, "(The source map has %u instructions, "
+		"but the program has %u!)\n",
+		map->num_instrs, p->program_words);
+    }
+    unsigned long total = 0;
+    for (unsigned int wa = 0; wa < map->num_instrs && wa < p->program_words;
+	 wa++) {
+	unsigned int stmt = map->stmt_of[wa];
+	stmt_counts[stmt] += p->executions[wa];
+	line_counts[source_map_stmt_line(map, stmt)] += p->executions[wa];
+	total += p->executions[wa];
+    }
+
+    unsigned int num_executed = 0;
+    for (unsigned int i = 0; i <= map->num_stmts; i++) {
+	if (stmt_counts[i] > 0) {
+	    sorted[num_executed].index = i;
+	    sorted[num_executed].count = stmt_counts[i];
+	    num_executed++;
+	}
+    }
+    qsort(sorted, num_executed, sizeof(counted_t), compare_counted);
+    fprintf(out, "Profile by statement of %s:\n", map->source_name);
+    fprintf(out, "%8s %-10s %12s %7s\n", "line", "statement", "count", "%");
+    for (unsigned int i = 0; i < num_executed; i++) {
+	unsigned int stmt = sorted[i].index;
+	if (stmt == 0) {
+	    fprintf(out, "%8s %-10s", "", "(none)");
+	} else {
+	    fprintf(out, "%8u %-10s", map->stmts[stmt].line,
+		    map->stmts[stmt].kind);
+	}
+	fprintf(out, " %12lu %7.2f\n", sorted[i].count,
+		percent(sorted[i].count, total));
+    }
+
+    fprintf(out, "Profile by line of %s:\n", map->source_name);
+    fprintf(out, "%12s %7s %6s  %s\n", "count", "%", "line", "source");
+    char *text = NULL;
+    size_t text_size = 0;
+    unsigned int line = 1;
+    while (true) {
+	ssize_t len = -1;
+	if (source != NULL) {
+	    len = getline(&text, &text_size, source);
+	}
+	if (len < 0 && line > max_line) {
+	    break;
+	}
+	if (len > 0 && text[len - 1] == '\n') {
+	    text[len - 1] = '\0';
+	}
+	unsigned long count = (line <= max_line) ? line_counts[line] : 0;
+	if (count > 0) {
+	    fprintf(out, "%12lu %7.2f", count, percent(count, total));
+	} else {
+	    fprintf(out, "%12s %7s", "", "");
+	}
+	fprintf(out, " %6u  %s\n", line, (len < 0) ? "" : text);
+	line++;
+    }
+    free(text);
+    free(sorted);
+    free(line_counts);
+    free(stmt_counts);
+}
+
+// Write the name of the frame for the call tree node n to out,
+// as described for profile_write_folded
+static void print_frame_name(call_node_t *n, source_map_t *map, FILE *out)
+{
+    if (n->parent == NULL) {
+	fprintf(out, "main");
+	return;
+    }
+    fprintf(out, "proc@%u", n->callee);
+    unsigned int wa = n->callee / BYTES_PER_WORD;
+    if (map != NULL && wa < map->num_instrs && map->stmt_of[wa] != 0) {
+	fprintf(out, " (line %u)", source_map_stmt_line(map, map->stmt_of[wa]));
+    }
+}
+
+// Write the stack of calls of the call tree node n to out,
+// with the names of its frames (outermost first) separated by semicolons
+static void print_stack(call_node_t *n, source_map_t *map, FILE *out)
+{
+    if (n->parent != NULL) {
+	print_stack(n->parent, map, out);
+	fprintf(out, ";");
+    }
+    print_frame_name(n, map, out);
+}
+
+// Write the folded-stack line for each node of the call tree
+// rooted at n, and for each of its descendants, whose count is not 0
+// to out (in depth-first order)
+static void write_folded_tree(call_node_t *n, source_map_t *map, FILE *out)
+{
+    for (/* n */; n != NULL; n = n->next_sibling) {
+	if (n->count > 0) {
+	    print_stack(n, map, out);
+	    fprintf(out, " %lu\n", n->count);
+	}
+	write_folded_tree(n->first_child, map, out);
+    }
+}
+
+// Write the instruction counts of each stack of calls in p to out
+// in the folded-stack format read by flamegraph.pl
+// (see profile.h)
+void profile_write_folded(profile_t *p, source_map_t *map, FILE *out)
+{
+    write_folded_tree(p->call_root, map, out);
+}
@@ -0,0 +1,116 @@
+/* $Id$ */
+// Execution profiles of the loaded program, for the VM's profiling engine
+#ifndef _PROFILE_H
+#define _PROFILE_H
+#include <stdio.h>
+#include "decode.h"
+#include "instruction.h"
+#include "source_map.h"
+
+// a node of a profile's call tree, which stands for a stack of calls
+// (the path from the root to it), where the root stands for the program
+// before it calls anything
+typedef struct call_node_s {
+    // the byte address of the procedure called (the JAL's target),
+    // or, for the root, the address the program starts at
+    address_type callee;
+    // the number of instructions executed with this stack of calls
+    unsigned long count;
+    // the node whose stack this one's extends, or NULL for the root
+    struct call_node_s *parent;
+    // the first node whose stack extends this one's by one call,
+    // and the next node whose stack extends parent's
+    // (so the children of a node are in the order they were first called)
+    struct call_node_s *first_child;
+    struct call_node_s *next_sibling;
+} call_node_t;
+
+// a frame of a profile's shadow call stack
+typedef struct {
+    // the call tree node of the stack of calls up to and including this one
+    call_node_t *node;
+    // the byte address the call returns to
+    address_type return_address;
+} call_frame_t;
+
+// the counts gathered while profiling a program
+// (the profiling engine increments them directly)
+typedef struct {
+    // the number of words of the program's text
+    unsigned int program_words;
+    // the number of times the instruction at each word address was executed
+    unsigned long *executions;
+    // the number of times the conditional branch at each word address
+    // was taken and not taken (0 for other instructions)
+    unsigned long *taken;
+    unsigned long *not_taken;
+    // the number of executions of each kind of instruction,
+    // i.e., of each opcode, function code, or system call
+    unsigned long handler_counts[NUM_HANDLERS];
+    // the root of the call tree
+    call_node_t *call_root;
+    // the shadow call stack, which holds stack_depth frames
+    // (in room for stack_size), and the call tree node
+    // of the current stack of calls
+    call_frame_t *stack;
+    unsigned int stack_depth;
+    unsigned int stack_size;
+    call_node_t *current;
+} profile_t;
+
+// Return a new profile, with all counts 0,
+// of a program with count words of text that starts at start_address
+extern profile_t *profile_create(unsigned int count,
+				 address_type start_address);
+
+// Free the profile p
+extern void profile_destroy(profile_t *p);
+
+// Record in p that a JAL has called the procedure at byte address target,
+// which will return to return_address
+extern void profile_call(profile_t *p, address_type target,
+			 address_type return_address);
+
+// Record in p that a JR has jumped to byte address target, which returns
+// from the innermost call on the shadow call stack that returns there
+// (if any; otherwise the JR is not a return)
+extern void profile_jump_register(profile_t *p, address_type target);
+
+// Requires: instrs has p->program_words elements
+// Print a report of p to out, for the program whose text is instrs:
+// the executed instructions, from the most executed to the least,
+// with the outcomes of conditional branches,
+// then the number of executions of each kind of instruction
+extern void profile_print_report(profile_t *p, const bin_instr_t *instrs,
+				 FILE *out);
+
+// Requires: instrs has p->program_words elements
+// Write p to out in CSV form, for the program whose text is instrs,
+// with a heading line and then one line per word of text, in order:
+// address,count,instruction,taken,not_taken
+// (where the last two are empty for instructions that are not
+// conditional branches)
+extern void profile_write_csv(profile_t *p, const bin_instr_t *instrs,
+			      FILE *out);
+
+// Write the instruction counts of each stack of calls in p to out
+// in the folded-stack format read by flamegraph.pl:
+// one line per stack of calls whose count is not 0,
+// with the names of its frames (outermost first) separated
+// by semicolons, a space, and the count. The outermost frame is "main",
+// and the others are named "proc@a", where a is the procedure's address,
+// followed by " (line n)" if the source map map (which may be NULL)
+// puts the procedure's first instruction in a statement on line n
+extern void profile_write_folded(profile_t *p, source_map_t *map, FILE *out);
+
+// Requires: map is the source map of the program profiled in p
+// Print a report of p in terms of the program's source to out:
+// the number of instructions executed for each statement,
+// from the most to the least, then the source file (read from source,
+// unless that is NULL) with the number executed for each line.
+// (The instructions of a statement exclude those of
+// the statements inside it.)
+extern void profile_print_source_report(profile_t *p, source_map_t *map,
+					FILE *source, FILE *out);
+
+#endif
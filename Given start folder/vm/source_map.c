@@ -0,0 +1,157 @@
+/* $Id$ */
+#include <stdlib.h>
+#include <string.h>
+#include "source_map.h"
+#include "machine_types.h"
+#include "utilities.h"
+
+// the size of the buffers for names read from a map
+#define MAP_NAME_SIZE 4096
+
+// the number of statements and instructions a new map has room for
+// (the arrays double in size when they fill up)
+#define INITIAL_MAP_SIZE 64
+
+// Return a fresh copy of s (bailing if there is no space for it)
+static char *copy_string(const char *s)
+{
+    char *ret = (char *)malloc(strlen(s) + 1);
+    if (ret == NULL) {
+	bail_with_error("Cannot allocate space for a map's string!");
+    }
+    strcpy(ret, s);
+    return ret;
+}
+
+// Return a new, empty map for the source file named source_name
+source_map_t *source_map_create(const char *source_name)
+{
+    source_map_t *m = (source_map_t *)malloc(sizeof(source_map_t));
+    if (m == NULL) {
+	bail_with_error("Cannot allocate space for a map!");
+    }
+    m->source_name = copy_string(source_name);
+    m->num_stmts = 0;
+    m->stmts_size = INITIAL_MAP_SIZE;
+    m->stmts = (source_map_stmt_t *)
+	malloc(m->stmts_size * sizeof(source_map_stmt_t));
+    m->num_instrs = 0;
+    m->stmt_of_size = INITIAL_MAP_SIZE;
+    m->stmt_of = (unsigned int *)
+	malloc(m->stmt_of_size * sizeof(unsigned int));
+    if (m->stmts == NULL || m->stmt_of == NULL) {
+	bail_with_error("Cannot allocate space for a map!");
+    }
+    return m;
+}
+
+// Free the map m
+void source_map_destroy(source_map_t *m)
+{
+    for (unsigned int i = 1; i <= m->num_stmts; i++) {
+	free((char *)m->stmts[i].kind);
+    }
+    free(m->stmts);
+    free(m->stmt_of);
+    free((char *)m->source_name);
+    free(m);
+}
+
+// Add a statement, of the given kind, that starts on the given line,
+// to the map m, and return its number
+unsigned int source_map_add_stmt(source_map_t *m, unsigned int line,
+				 const char *kind)
+{
+    m->num_stmts++;
+    // (stmts[0] is not used)
+    if (m->num_stmts == m->stmts_size) {
+	m->stmts_size = 2 * m->stmts_size;
+	m->stmts = (source_map_stmt_t *)
+	    realloc(m->stmts, m->stmts_size * sizeof(source_map_stmt_t));
+	if (m->stmts == NULL) {
+	    bail_with_error("Cannot allocate space for a map's statements!");
+	}
+    }
+    m->stmts[m->num_stmts].line = line;
+    m->stmts[m->num_stmts].kind = copy_string(kind);
+    return m->num_stmts;
+}
+
+// Add the next instruction of the program to the map m,
+// as part of the code of the statement numbered stmt (or of none, if 0)
+void source_map_add_instr(source_map_t *m, unsigned int stmt)
+{
+    if (m->num_instrs == m->stmt_of_size) {
+	m->stmt_of_size = 2 * m->stmt_of_size;
+	m->stmt_of = (unsigned int *)
+	    realloc(m->stmt_of, m->stmt_of_size * sizeof(unsigned int));
+	if (m->stmt_of == NULL) {
+	    bail_with_error("Cannot allocate space for a map's instructions!");
+	}
+    }
+    m->stmt_of[m->num_instrs++] = stmt;
+}
+
+// Requires: the statement numbered stmt is in m
+// Return the line of the source file that the statement numbered stmt
+// starts on, or 0 if stmt is 0
+unsigned int source_map_stmt_line(source_map_t *m, unsigned int stmt)
+{
+    return (stmt == 0) ? 0 : m->stmts[stmt].line;
+}
+
+// Requires: out is open for writing
+// Write the map m to out (in the format described in source_map.h)
+void source_map_write(source_map_t *m, FILE *out)
+{
+    fprintf(out, "# PC-to-source map\n");
+    fprintf(out, "source %s\n", m->source_name);
+    fprintf(out, "statements %u\n", m->num_stmts);
+    for (unsigned int i = 1; i <= m->num_stmts; i++) {
+	fprintf(out, "%u %u %s\n", i, m->stmts[i].line, m->stmts[i].kind);
+    }
+    fprintf(out, "instructions %u\n", m->num_instrs);
+    for (unsigned int i = 0; i < m->num_instrs; i++) {
+	fprintf(out, "%u %u\n", i * BYTES_PER_WORD, m->stmt_of[i]);
+    }
+}
+
+// Return the map read from the file named filename,
+// or NULL if that file cannot be opened.
+// Exit with an error message if it is not a valid map.
+source_map_t *source_map_read(const char *filename)
+{
+    FILE *in = fopen(filename, "r");
+    if (in == NULL) {
+	return NULL;
+    }
+    char name[MAP_NAME_SIZE];
+    unsigned int count;
+    if (fscanf(in, "# PC-to-source map source %4095s statements %u",
+	       name, &count) != 2) {
+	bail_with_error("%s is not a valid map file!", filename);
+    }
+    source_map_t *m = source_map_create(name);
+    for (unsigned int i = 1; i <= count; i++) {
+	unsigned int num, line;
+	if (fscanf(in, "%u %u %4095s", &num, &line, name) != 3 || num != i) {
+	    bail_with_error("Statement %u in the map file %s is not valid!",
+			    i, filename);
+	}
+	source_map_add_stmt(m, line, name);
+    }
+    if (fscanf(in, " instructions %u", &count) != 1) {
+	bail_with_error("%s is not a valid map file!", filename);
+    }
+    for (unsigned int i = 0; i < count; i++) {
+	unsigned int addr, stmt;
+	if (fscanf(in, "%u %u", &addr, &stmt) != 2
+	    || addr != i * BYTES_PER_WORD || stmt > m->num_stmts) {
+	    bail_with_error("Instruction %u in the map file %s is not valid!",
+			    i, filename);
+	}
+	source_map_add_instr(m, stmt);
+    }
+    fclose(in);
+    return m;
+}
@@ -0,0 +1,78 @@
+/* $Id$ */
+// Maps from the addresses of a compiled program's instructions
+// to the PL/0 statements (and so the source lines) they came from.
+// The compiler writes a map (with -g) to a file named like the .bof file,
+// but with the suffix .map, which the VM's profiler (-P) reads.
+// The file is text: a heading, the name of the source file,
+// a line for each statement (its number, line, and kind),
+// then a line for each instruction (its byte address, and the
+// number of the innermost statement whose code it is part of,
+// or 0 if it is not part of any statement's code), e.g.,
+//   # PC-to-source map
+//   source hw4-gtest9.pl0
+//   statements 2
+//   1 2 if
+//   2 3 write
+//   instructions 12
+//   0 0
+//   4 1
+//   ...
+#ifndef _SOURCE_MAP_H
+#define _SOURCE_MAP_H
+#include <stdio.h>
+
+// a statement in a map
+typedef struct {
+    // the line of the source file on which it starts
+    unsigned int line;
+    // the kind of statement (e.g., "while")
+    const char *kind;
+} source_map_stmt_t;
+
+// a map from the instructions of a program to its statements
+typedef struct {
+    // the name of the source file (which is in the map's directory)
+    const char *source_name;
+    // the statements, numbered from 1 (stmts[0] is not used),
+    // with room for stmts_size elements
+    unsigned int num_stmts;
+    unsigned int stmts_size;
+    source_map_stmt_t *stmts;
+    // the number of the statement of the instruction at each word address
+    // (0 for instructions that are not part of any statement's code),
+    // with room for stmt_of_size elements
+    unsigned int num_instrs;
+    unsigned int stmt_of_size;
+    unsigned int *stmt_of;
+} source_map_t;
+
+// Return a new, empty map for the source file named source_name
+extern source_map_t *source_map_create(const char *source_name);
+
+// Free the map m
+extern void source_map_destroy(source_map_t *m);
+
+// Add a statement, of the given kind, that starts on the given line,
+// to the map m, and return its number
+extern unsigned int source_map_add_stmt(source_map_t *m, unsigned int line,
+					const char *kind);
+
+// Add the next instruction of the program to the map m,
+// as part of the code of the statement numbered stmt (or of none, if 0)
+extern void source_map_add_instr(source_map_t *m, unsigned int stmt);
+
+// Requires: the statement numbered stmt is in m
+// Return the line of the source file that the statement numbered stmt
+// starts on, or 0 if stmt is 0
+extern unsigned int source_map_stmt_line(source_map_t *m, unsigned int stmt);
+
+// Requires: out is open for writing
+// Write the map m to out (in the format described above)
+extern void source_map_write(source_map_t *m, FILE *out);
+
+// Return the map read from the file named filename,
+// or NULL if that file cannot be opened.
+// Exit with an error message if it is not a valid map.
+extern source_map_t *source_map_read(const char *filename);
+
+#endif
@@ -0,0 +1,554 @@
+/* $Id$ */
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include "trace.h"
+#include "machine.h"
+#include "utilities.h"
+
+#define MAX_PRINT_WIDTH 59
+
+// the bytes a binary trace starts with
+#define TRACE_MAGIC "SRMT"
+#define TRACE_MAGIC_SIZE 4
+
+// the kinds of records in a binary trace (see trace.h)
+#define SYNC_RECORD 'S'
+#define REGISTER_RECORD 'R'
+#define HILO_RECORD 'H'
+#define STORE_RECORD 'M'
+#define STATE_RECORD 'D'
+#define EXECUTING_RECORD 'I'
+#define OUTPUT_RECORD 'O'
+#define ERROR_RECORD 'E'
+
+// the text printed for a region of memory, which a cache keeps
+// until a word in the region is stored into or the region changes
+typedef struct {
+    // the word addresses of the first and last words of the region
+    // (start > end if no text is kept)
+    int start;
+    int end;
+    // the text (len bytes, in room for size bytes), and does it end
+    // with a newline?
+    char *text;
+    size_t len;
+    size_t size;
+    bool printed_trailing_newline;
+} region_text_t;
+
+// the number of bits in each word of a cache's dirty bitmap
+#define DIRTY_BITS 64
+
+// what a trace cache holds (see trace.h)
+struct trace_cache_s {
+    // which words of memory have been stored into since the last
+    // state was printed (one bit per word), and the range of words
+    // of the bitmap that have any bit set (if dirty_min <= dirty_max)
+    unsigned long long dirty[MEMORY_SIZE_IN_WORDS / DIRTY_BITS + 1];
+    unsigned int dirty_min;
+    unsigned int dirty_max;
+    // the text of the global data and of the stack
+    region_text_t globals;
+    region_text_t stack;
+};
+
+// Return a new, empty cache of printed text
+trace_cache_t *trace_cache_create()
+{
+    trace_cache_t *c = (trace_cache_t *)calloc(1, sizeof(trace_cache_t));
+    if (c == NULL) {
+	bail_with_error("Cannot allocate space for a trace cache!");
+    }
+    trace_cache_invalidate(c);
+    return c;
+}
+
+// Free the cache c
+void trace_cache_destroy(trace_cache_t *c)
+{
+    free(c->globals.text);
+    free(c->stack.text);
+    free(c);
+}
+
+// Requires: wa < MEMORY_SIZE_IN_WORDS
+// Record in c that the word at word address wa was stored into
+void trace_cache_note_store(trace_cache_t *c, address_type wa)
+{
+    unsigned int i = wa / DIRTY_BITS;
+    c->dirty[i] |= 1ULL << (wa % DIRTY_BITS);
+    if (i < c->dirty_min) {
+	c->dirty_min = i;
+    }
+    if (i > c->dirty_max) {
+	c->dirty_max = i;
+    }
+}
+
+// Mark the bitmap of c clean
+static void cache_clean(trace_cache_t *c)
+{
+    for (unsigned int i = c->dirty_min; i <= c->dirty_max; i++) {
+	c->dirty[i] = 0;
+    }
+    c->dirty_min = MEMORY_SIZE_IN_WORDS;
+    c->dirty_max = 0;
+}
+
+// Make c forget all of the text it holds
+// (e.g., because memory changed without c being told)
+void trace_cache_invalidate(trace_cache_t *c)
+{
+    c->globals.start = c->stack.start = 1;
+    c->globals.end = c->stack.end = 0;
+    c->dirty_min = 0;
+    c->dirty_max = MEMORY_SIZE_IN_WORDS / DIRTY_BITS;
+    cache_clean(c);
+}
+
+// Return true if the text of r, which is for the words
+// from start to end (inclusive) in the cache c, is out of date
+static bool region_stale(trace_cache_t *c, region_text_t *r,
+			 int start, int end)
+{
+    if (r->start != start || r->end != end
+	|| start < 0 || end >= MEMORY_SIZE_IN_WORDS) {
+	return true;
+    }
+    unsigned int first = start / DIRTY_BITS;
+    unsigned int last = end / DIRTY_BITS;
+    if (first < c->dirty_min) {
+	first = c->dirty_min;
+    }
+    if (last > c->dirty_max) {
+	last = c->dirty_max;
+    }
+    for (unsigned int i = first; i <= last; i++) {
+	unsigned long long bits = c->dirty[i];
+	if (i == start / DIRTY_BITS) {
+	    bits &= ~0ULL << (start % DIRTY_BITS);
+	}
+	if (i == end / DIRTY_BITS && end % DIRTY_BITS != DIRTY_BITS - 1) {
+	    bits &= (1ULL << (end % DIRTY_BITS + 1)) - 1;
+	}
+	if (bits != 0) {
+	    return true;
+	}
+    }
+    return false;
+}
+
+// Append text formatted (as by printf) by fmt to the text of r,
+// and return the number of characters appended
+static int region_printf(region_text_t *r, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int count = vsnprintf(r->text + r->len, r->size - r->len, fmt, args);
+    va_end(args);
+    if (r->len + count >= r->size) {
+	r->size = 2 * (r->len + count) + 128;
+	r->text = (char *)realloc(r->text, r->size);
+	if (r->text == NULL) {
+	    bail_with_error("Cannot allocate space for the text of a trace!");
+	}
+	va_start(args, fmt);
+	vsnprintf(r->text + r->len, r->size - r->len, fmt, args);
+	va_end(args);
+    }
+    r->len += count;
+    return count;
+}
+
+// print the memory location of s at word address a to r
+// (using the byte address, whic is WORDS_PER_BYTE times a)
+// with a format determined by fmt and no newline,
+// returns the number of characters written
+static int print_loc(const trace_state_t *s, region_text_t *r, int a, char fmt)
+{
+    int count;
+    if (fmt == 'x') {
+	count = region_printf(r, "%8d: 0x%x\t", a*BYTES_PER_WORD, s->words[a]);
+    } else {
+	count = region_printf(r, "%8d: %d\t", a*BYTES_PER_WORD, s->words[a]);
+    }
+    return count;
+}
+
+// Print the address a and the instruction bi to out, on a line
+void trace_print_instruction(FILE *out, address_type a, bin_instr_t bi)
+{
+    fprintf(out, "%4d %s\n", a, instruction_assembly_form(bi));
+}
+
+// Print the line that starts the trace of executing
+// the instruction bi, at address a, to out
+void trace_print_executing(FILE *out, address_type a, bin_instr_t bi)
+{
+    fprintf(out, "==> addr: ");
+    trace_print_instruction(out, a, bi);
+}
+
+// make r the text of s's word memory in hex or decimal based on
+// the fmt argument between start (inclusive) and end (inclusive),
+// without a newline and eliding most elements that are 0
+static void print_memory_nonzero(const trace_state_t *s, region_text_t *r,
+				 int start, int end, char fmt)
+{
+    r->start = start;
+    r->end = end;
+    r->len = 0;
+    bool printed_trailing_newline = false;
+    bool no_dots_yet = true;
+    // count of chars on a line
+    int lc = 0;
+    for (int a = start; a <= end; a++) {
+	if (s->words[a] != 0) {
+	    lc += print_loc(s, r, a, fmt);
+	    printed_trailing_newline = false;
+	    no_dots_yet = true;
+	} else { // words[a] == 0
+	    if (no_dots_yet) {
+		lc += print_loc(s, r, a, fmt);
+		lc += region_printf(r, "...");
+		printed_trailing_newline = false;
+		no_dots_yet = false;
+	    }
+	}
+	if (lc > MAX_PRINT_WIDTH) {
+	    region_printf(r, "\n");
+	    printed_trailing_newline = true;
+	    lc = 0;
+	}
+    }
+    r->printed_trailing_newline = printed_trailing_newline;
+}
+
+// Print the nonzero memory locations of s between start and end
+// (inclusive) on out, in decimal notation, ending with a newline
+// and eliding most elements that are 0, reusing the text of r
+// (which is in s's cache) if it is still up to date
+static void print_memory_words_d(const trace_state_t *s, region_text_t *r,
+				 FILE *out, int start, int end)
+{
+    region_text_t text = {1, 0, NULL, 0, 0, false};
+    if (s->cache == NULL) {
+	r = &text;
+    }
+    if (s->cache == NULL || region_stale(s->cache, r, start, end)) {
+	print_memory_nonzero(s, r, start, end, 'd');
+    }
+    fwrite(r->text, 1, r->len, out);
+    if (!r->printed_trailing_newline) {
+	fprintf(out, "\n");
+    }
+    fflush(out);
+    free(text.text);
+}
+
+// Print the non-zero global data of s to out
+void trace_print_global_data(FILE *out, const trace_state_t *s)
+{
+    int global_wa = s->GPR[GP] / BYTES_PER_WORD;
+    print_memory_words_d(s, (s->cache == NULL) ? NULL : &s->cache->globals,
+			 out, global_wa, global_wa + s->global_data_words);
+}
+
+#define    REGFORMAT1 "GPR[%-3s]: %-4d"
+#define    REGFORMAT2 "\tGPR[%-3s]: %-4d"
+
+// Requires: out != NULL and out can be written on
+// Print the values in s's registers to out
+static void print_registers(const trace_state_t *s, FILE *out)
+{
+    // print the registers
+    fprintf(out, "%8s: %u", "PC", s->PC);
+    if (s->hi != 0 || s->lo != 0) {
+	fprintf(out, "\t%8s: %d\t%8s: %d", "HI", s->hi, "LO", s->lo);
+    }
+    newline(out);
+    int j;
+
+    for (j = 0; j < (NUM_REGISTERS - 6); /* nothing */) {
+	fprintf(out, REGFORMAT1, regname_get(j), s->GPR[j]);
+	j++;
+	for (int i = 0; i < 5; i++) {
+	    fprintf(out, REGFORMAT2, regname_get(j), s->GPR[j]);
+	    j++;
+	}
+	newline(out);
+    }
+    fprintf(out, REGFORMAT1, regname_get(j), s->GPR[j]);
+    j++;
+    fprintf(out, REGFORMAT2, regname_get(j), s->GPR[j]);
+    j++;
+    newline(out);
+}
+
+// Print s's non-zero memory between GPR[SP] and the stack bottom
+static void print_runtime_stack_AR(const trace_state_t *s, FILE *out)
+{
+    // print the memory between sp and stack_bottom_address, inclusive
+    print_memory_words_d(s, (s->cache == NULL) ? NULL : &s->cache->stack,
+			 out, s->GPR[SP] / BYTES_PER_WORD,
+			 (s->stack_bottom_address / BYTES_PER_WORD)+1);
+}
+
+// Requires: out != NULL and out can be written on
+// Print s (registers, globals, and the memory between
+// GPR[$sp] and the stack bottom, inclusive) to out
+// (and, if s has a cache, mark its memory clean)
+void trace_print_state(FILE *out, const trace_state_t *s)
+{
+    print_registers(s, out);
+    trace_print_global_data(out, s);
+    print_runtime_stack_AR(s, out);
+    if (s->cache != NULL) {
+	cache_clean(s->cache);
+    }
+}
+
+// Write the record kind kind, followed by the count words in fields,
+// to the binary trace trace
+static void write_record(FILE *trace, char kind, int count,
+			 const word_type *fields)
+{
+    fputc(kind, trace);
+    fwrite(fields, BYTES_PER_WORD, count, trace);
+}
+
+// Requires: trace is open for writing in binary
+// Write the start of a binary trace to trace
+void trace_write_header(FILE *trace)
+{
+    fwrite(TRACE_MAGIC, 1, TRACE_MAGIC_SIZE, trace);
+}
+
+// Write a record of the full state s to the binary trace trace
+void trace_write_sync(FILE *trace, const trace_state_t *s)
+{
+    word_type nonzero = 0;
+    for (address_type wa = 0; wa < MEMORY_SIZE_IN_WORDS; wa++) {
+	nonzero += (s->words[wa] != 0);
+    }
+    word_type fields[] = {s->PC};
+    write_record(trace, SYNC_RECORD, 1, fields);
+    fwrite(s->GPR, BYTES_PER_WORD, NUM_REGISTERS, trace);
+    word_type rest[] = {s->hi, s->lo, s->global_data_words,
+			s->stack_bottom_address, nonzero};
+    fwrite(rest, BYTES_PER_WORD, 5, trace);
+    for (address_type wa = 0; wa < MEMORY_SIZE_IN_WORDS; wa++) {
+	if (s->words[wa] != 0) {
+	    word_type pair[] = {wa, s->words[wa]};
+	    fwrite(pair, BYTES_PER_WORD, 2, trace);
+	}
+    }
+}
+
+// Write a record that register r was set to value to the binary trace trace
+void trace_write_register(FILE *trace, unsigned int r, word_type value)
+{
+    fputc(REGISTER_RECORD, trace);
+    fputc(r, trace);
+    fwrite(&value, BYTES_PER_WORD, 1, trace);
+}
+
+// Write a record that HI and LO were set to hi and lo
+// to the binary trace trace
+void trace_write_hilo(FILE *trace, word_type hi, word_type lo)
+{
+    word_type fields[] = {hi, lo};
+    write_record(trace, HILO_RECORD, 2, fields);
+}
+
+// Write a record that the word at word address wa was set to value
+// to the binary trace trace
+void trace_write_store(FILE *trace, address_type wa, word_type value)
+{
+    word_type fields[] = {wa, value};
+    write_record(trace, STORE_RECORD, 2, fields);
+}
+
+// Write a record of the state after an instruction, whose PC is PC,
+// to the binary trace trace
+void trace_write_state(FILE *trace, address_type PC)
+{
+    word_type fields[] = {PC};
+    write_record(trace, STATE_RECORD, 1, fields);
+}
+
+// Write a record that the instruction at byte address a was executed
+// to the binary trace trace
+void trace_write_executing(FILE *trace, address_type a)
+{
+    word_type fields[] = {a};
+    write_record(trace, EXECUTING_RECORD, 1, fields);
+}
+
+// Write a record of the len bytes of the program's output starting at s
+// to the binary trace trace
+void trace_write_output(FILE *trace, const char *s, size_t len)
+{
+    word_type fields[] = {len};
+    write_record(trace, OUTPUT_RECORD, 1, fields);
+    fwrite(s, 1, len, trace);
+}
+
+// Write a record of the error message msg to the binary trace trace
+void trace_write_error(FILE *trace, const char *msg)
+{
+    size_t len = strlen(msg);
+    word_type fields[] = {len};
+    write_record(trace, ERROR_RECORD, 1, fields);
+    fwrite(msg, 1, len, trace);
+}
+
+// the binary trace being decoded, and its name (for error messages)
+typedef struct {
+    FILE *in;
+    const char *name;
+} trace_input_t;
+
+// Requires: buf has room for count words
+// Read count words from the trace t into buf
+// (exiting with an error message if the trace ends first)
+static void read_words(trace_input_t *t, word_type *buf, size_t count)
+{
+    if (fread(buf, BYTES_PER_WORD, count, t->in) != count) {
+	bail_with_error("The binary trace %s ends in the middle of a record!",
+			t->name);
+    }
+}
+
+// Return the next word of the trace t
+// (exiting with an error message if the trace ends first)
+static word_type read_word(trace_input_t *t)
+{
+    word_type w;
+    read_words(t, &w, 1);
+    return w;
+}
+
+// Requires: word_address is a word address read from the trace t
+// Return word_address, after checking that it is in the memory
+// (exiting with an error message if not)
+static address_type check_address(trace_input_t *t, word_type word_address)
+{
+    if ((address_type)word_address >= MEMORY_SIZE_IN_WORDS) {
+	bail_with_error("The binary trace %s has an invalid address (%u)!",
+			t->name, word_address);
+    }
+    return word_address;
+}
+
+// Read the n bytes of a message from the trace t and write them to out
+// (exiting with an error message if the trace ends first)
+static void copy_bytes(trace_input_t *t, size_t n, FILE *out)
+{
+    char buf[4096];
+    while (n > 0) {
+	size_t chunk = (n < sizeof(buf)) ? n : sizeof(buf);
+	if (fread(buf, 1, chunk, t->in) != chunk) {
+	    bail_with_error("The binary trace %s ends in the middle of a record!",
+			    t->name);
+	}
+	fwrite(buf, 1, chunk, out);
+	n -= chunk;
+    }
+}
+
+// Requires: trace is open for reading in binary
+// Print the text form of the binary trace trace (from the file named name)
+// to out, writing its error messages on err
+// (exiting with an error message if it is not a valid binary trace)
+void trace_decode(FILE *trace, const char *name, FILE *out, FILE *err)
+{
+    trace_input_t t = {trace, name};
+    char magic[TRACE_MAGIC_SIZE];
+    if (fread(magic, 1, TRACE_MAGIC_SIZE, trace) != TRACE_MAGIC_SIZE
+	|| memcmp(magic, TRACE_MAGIC, TRACE_MAGIC_SIZE) != 0) {
+	bail_with_error("%s is not a binary trace!", name);
+    }
+    // the state the trace describes (nothing is printed until
+    // the first full state, so it starts out all 0)
+    word_type *words = (word_type *)calloc(MEMORY_SIZE_IN_WORDS,
+					   sizeof(word_type));
+    if (words == NULL) {
+	bail_with_error("Cannot allocate space for a machine's memory!");
+    }
+    word_type GPR[NUM_REGISTERS] = {0};
+    trace_state_t s = {0, GPR, 0, 0, words, 0, 0, trace_cache_create()};
+    int kind;
+    while ((kind = fgetc(trace)) != EOF) {
+	switch (kind) {
+	case SYNC_RECORD:
+	    {
+		s.PC = read_word(&t);
+		read_words(&t, GPR, NUM_REGISTERS);
+		word_type rest[5];
+		read_words(&t, rest, 5);
+		s.hi = rest[0];
+		s.lo = rest[1];
+		s.global_data_words = rest[2];
+		s.stack_bottom_address = rest[3];
+		memset(words, 0, MEMORY_SIZE_IN_WORDS * sizeof(word_type));
+		trace_cache_invalidate(s.cache);
+		for (word_type i = 0; i < rest[4]; i++) {
+		    address_type wa = check_address(&t, read_word(&t));
+		    words[wa] = read_word(&t);
+		}
+		trace_print_state(out, &s);
+	    }
+	    break;
+	case REGISTER_RECORD:
+	    {
+		int r = fgetc(trace);
+		if (r == EOF || r >= NUM_REGISTERS) {
+		    bail_with_error("The binary trace %s has an invalid register!",
+				    name);
+		}
+		GPR[r] = read_word(&t);
+	    }
+	    break;
+	case HILO_RECORD:
+	    s.hi = read_word(&t);
+	    s.lo = read_word(&t);
+	    break;
+	case STORE_RECORD:
+	    {
+		address_type wa = check_address(&t, read_word(&t));
+		words[wa] = read_word(&t);
+		trace_cache_note_store(s.cache, wa);
+	    }
+	    break;
+	case STATE_RECORD:
+	    s.PC = read_word(&t);
+	    trace_print_state(out, &s);
+	    break;
+	case EXECUTING_RECORD:
+	    {
+		address_type a = read_word(&t);
+		address_type wa = check_address(&t, a / BYTES_PER_WORD);
+		bin_instr_t bi;
+		memcpy(&bi, &words[wa], sizeof(bi));
+		trace_print_executing(out, a, bi);
+	    }
+	    break;
+	case OUTPUT_RECORD:
+	    copy_bytes(&t, read_word(&t), out);
+	    break;
+	case ERROR_RECORD:
+	    fflush(out); // so the message comes after the output before it
+	    copy_bytes(&t, read_word(&t), err);
+	    fflush(err);
+	    break;
+	default:
+	    bail_with_error("The binary trace %s has an invalid record (%d)!",
+			    name, kind);
+	    break;
+	}
+    }
+    trace_cache_destroy(s.cache);
+    free(words);
+}
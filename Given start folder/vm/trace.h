@@ -0,0 +1,134 @@
+/* $Id$ */
+// The VM's tracing output, both as text and in a compact binary form.
+// The text form is what the VM prints when tracing (with -t, or after
+// a STRA instruction): the machine's state (its registers, its global
+// data, and its stack), then, for each instruction executed,
+// a line with the instruction and the state after executing it.
+// The binary form (written by the VM with -T) holds the same information,
+// but only records what each instruction changed, so it is much smaller
+// and faster to write; the vm-trace program turns it back into
+// exactly the text the VM would have printed.
+//
+// A binary trace starts with the 4 bytes "SRMT", followed by records,
+// each a byte giving its kind followed by its fields, where each field
+// is a word (in the byte order of the machine that wrote the trace),
+// except where noted:
+//   'S' (a full state): PC, the NUM_REGISTERS registers, HI, LO,
+//       the number of words of global data, the stack bottom address,
+//       the number n of non-zero words of memory, then n pairs of
+//       a word address and that word (all other words are 0);
+//       the state is printed
+//   'R' (a register written): the register's number (a byte), its value
+//   'H' (HI and LO written): HI, LO
+//   'M' (a word of memory stored into): its word address, its value
+//   'D' (a state after an instruction): PC; the state, which is the last
+//       one printed changed by the 'R', 'H', and 'M' records since then,
+//       is printed
+//   'I' (an instruction executed): its byte address; the instruction
+//       there (in the state's memory) is printed
+//   'O' (the program's output): a length n, then n bytes of output
+//   'E' (an error message): a length n, then n bytes of the message
+//       (which the VM wrote on stderr)
+#ifndef _TRACE_H
+#define _TRACE_H
+#include <stdio.h>
+#include "machine_types.h"
+#include "instruction.h"
+#include "regname.h"
+
+// a cache of the text printed for the global data and the stack
+// when printing states, so each state printed only has to walk
+// the memory of a region again if a word in it was stored into
+// (or the region moved) since the last state printed
+typedef struct trace_cache_s trace_cache_t;
+
+// the state of a machine, as tracing prints it
+typedef struct {
+    address_type PC;
+    // the general purpose registers (NUM_REGISTERS of them)
+    const word_type *GPR;
+    word_type hi;
+    word_type lo;
+    // the machine's memory (MEMORY_SIZE_IN_WORDS words)
+    const word_type *words;
+    // the number of words of global data, starting at GPR[GP]
+    unsigned int global_data_words;
+    // the byte address of the bottom of the stack
+    address_type stack_bottom_address;
+    // the cache to use when printing the state, or NULL for none
+    trace_cache_t *cache;
+} trace_state_t;
+
+// Return a new, empty cache of printed text
+extern trace_cache_t *trace_cache_create();
+
+// Free the cache c
+extern void trace_cache_destroy(trace_cache_t *c);
+
+// Requires: wa < MEMORY_SIZE_IN_WORDS
+// Record in c that the word at word address wa was stored into
+extern void trace_cache_note_store(trace_cache_t *c, address_type wa);
+
+// Make c forget all of the text it holds
+// (e.g., because memory changed without c being told)
+extern void trace_cache_invalidate(trace_cache_t *c);
+
+// Print the address a and the instruction bi to out, on a line
+extern void trace_print_instruction(FILE *out, address_type a,
+				    bin_instr_t bi);
+
+// Print the line that starts the trace of executing
+// the instruction bi, at address a, to out
+extern void trace_print_executing(FILE *out, address_type a,
+				  bin_instr_t bi);
+
+// Print the non-zero global data of s to out
+extern void trace_print_global_data(FILE *out, const trace_state_t *s);
+
+// Requires: out != NULL and out can be written on
+// Print s (registers, globals, and the memory between
+// GPR[$sp] and the stack bottom, inclusive) to out
+// (and, if s has a cache, mark its memory clean)
+extern void trace_print_state(FILE *out, const trace_state_t *s);
+
+// Requires: trace is open for writing in binary
+// Write the start of a binary trace to trace
+extern void trace_write_header(FILE *trace);
+
+// Write a record of the full state s to the binary trace trace
+extern void trace_write_sync(FILE *trace, const trace_state_t *s);
+
+// Write a record that register r was set to value to the binary trace trace
+extern void trace_write_register(FILE *trace, unsigned int r,
+				 word_type value);
+
+// Write a record that HI and LO were set to hi and lo
+// to the binary trace trace
+extern void trace_write_hilo(FILE *trace, word_type hi, word_type lo);
+
+// Write a record that the word at word address wa was set to value
+// to the binary trace trace
+extern void trace_write_store(FILE *trace, address_type wa, word_type value);
+
+// Write a record of the state after an instruction, whose PC is PC,
+// to the binary trace trace
+extern void trace_write_state(FILE *trace, address_type PC);
+
+// Write a record that the instruction at byte address a was executed
+// to the binary trace trace
+extern void trace_write_executing(FILE *trace, address_type a);
+
+// Write a record of the len bytes of the program's output starting at s
+// to the binary trace trace
+extern void trace_write_output(FILE *trace, const char *s, size_t len);
+
+// Write a record of the error message msg to the binary trace trace
+extern void trace_write_error(FILE *trace, const char *msg);
+
+// Requires: trace is open for reading in binary
+// Print the text form of the binary trace trace (from the file named name)
+// to out, writing its error messages on err
+// (exiting with an error message if it is not a valid binary trace)
+extern void trace_decode(FILE *trace, const char *name, FILE *out, FILE *err);
+
+#endif
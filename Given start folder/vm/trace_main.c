@@ -0,0 +1,38 @@
+/* $Id$ */
+// vm-trace: print a binary trace written by the VM (with -T) as text,
+// exactly as the VM would have printed the trace,
+// along with the program's output (on stdout) and error messages (on stderr)
+#include <stdio.h>
+#include <stdlib.h>
+#include "trace.h"
+#include "utilities.h"
+
+static char *progname;
+
+void usage() {
+    bail_with_error("Usage: %s file.trace", progname);
+}
+
+int main(int argc, char *argv[]) {
+    // set the program's name
+    progname = argv[0];
+    argc--;
+    argv++;
+
+    if (argc != 1) {
+	usage();
+    }
+
+    // name of the file to read
+    const char *tracename = argv[0];
+
+    FILE *trace = fopen(tracename, "rb");
+    if (trace == NULL) {
+	bail_with_error("Error opening file for reading: %s", tracename);
+    }
+
+    trace_decode(trace, tracename, stdout, stderr);
+    fclose(trace);
+
+    return EXIT_SUCCESS;
+}
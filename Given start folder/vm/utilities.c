@@ -74,3 +74,20 @@ void newline(FILE *out)
     fprintf(out, "\n");
     fflush(out);
 }
+
+// Return the number given by the argument arg of the command line
+// option named option (exiting with an error message
+// if it is not a positive number)
+unsigned long parse_count(const char *option, const char *arg)
+{
+    char *end;
+    errno = 0;
+    unsigned long count = strtoul(arg, &end, 10);
+    if (arg[0] < '0' || arg[0] > '9' || *end != '\0' || errno != 0
+	|| count == 0) {
+	errno = 0;
+	bail_with_error("The number given with %s must be a positive number,"
+			" not %s!", option, arg);
+    }
+    return count;
+}
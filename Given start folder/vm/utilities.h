@@ -20,4 +20,9 @@ extern void bail_with_error(const char *fmt, ...);
 // print a newline on out and flush out
 extern void newline(FILE *out);
 
+// Return the number given by the argument arg of the command line
+// option named option (exiting with an error message
+// if it is not a positive number)
+extern unsigned long parse_count(const char *option, const char *arg);
+
 #endif